@@ -66,7 +66,81 @@ void initialise( int argc, char *argv[] ){
 	parse_input_parameters( argc, argv );
 
 	// Initialise random numbers generator
-	initialise_random( seed );
+	initialise_random( Context::current()->seed );
+
+	// Service mode: requests served until the process is stopped (data sets loaded on request)
+	if( Service::enabled() ){
+
+		if( Batch::enabled() || MultiRun::enabled() || num_islands > 1 || num_processes > 1 || !connect_address.empty() ){
+
+			error_message_exit( "Service mode cannot be combined with batch or multi-run modes or island models (--batch, --runs, --seeds, --islands, --processes, --connect)" );
+
+		}
+
+		if( algorithm_name != "nsga2" ){
+
+			show_usage( string( argv[0] ) );
+			error_message_exit( "Unrecognised search algorithm (-a,--algorithm): " + algorithm_name );
+
+		}
+
+		ALGO = AlgorithmPtr( new Service() );
+		return;
+
+	}
+
+	// Batch mode: one run per data set, each with its own problem instance
+	if( Batch::enabled() ){
+
+		if( MultiRun::enabled() || num_islands > 1 || num_processes > 1 || !connect_address.empty() ){
+
+			error_message_exit( "Batch mode cannot be combined with multi-run mode or island models (--runs, --seeds, --islands, --processes, --connect)" );
+
+		}
+
+		if( algorithm_name != "nsga2" ){
+
+			show_usage( string( argv[0] ) );
+			error_message_exit( "Unrecognised search algorithm (-a,--algorithm): " + algorithm_name );
+
+		}
+
+		BatchPtr batch = BatchPtr( new Batch() );
+
+		// Order of the runs and estimated footprints only
+		if( estimate_memory ){
+
+			batch->schedule( cout );
+			exit( 0 );
+
+		}
+
+		ALGO = AlgorithmPtr( batch );
+		return;
+
+	}
+
+	// Memory footprint estimate (before anything is allocated)
+	if( estimate_memory ){
+
+		Memory::estimate( cout, max( num_islands, 1 ) );
+		exit( 0 );
+
+	}
+
+	// Multi-run mode: runs are read first (the problem instance is shared by all runs)
+	MultiRunPtr runs = nullptr;
+	if( MultiRun::enabled() ){
+
+		if( num_islands > 1 || num_processes > 1 || !connect_address.empty() ){
+
+			error_message_exit( "Island models cannot be used in multi-run mode (--islands, --processes, --connect)" );
+
+		}
+
+		runs = MultiRunPtr( new MultiRun() );
+
+	}
 
 	// Create and configure problem instance	
 	PROBLEM = ClusteringProblemPtr( new ClusteringProblem() );
@@ -74,7 +148,13 @@ void initialise( int argc, char *argv[] ){
 	// Instantiate and configure search algorithm
 	if( algorithm_name == "nsga2" ){
 
-		ALGO = AlgorithmPtr( new Nsga2() );
+		// Multi-run mode: several Nsga2 runs (seeds, configurations) on separate threads
+		// Island models: several Nsga2 populations on separate processes or threads
+		if( runs != nullptr ) ALGO = AlgorithmPtr( runs );
+		else if( !connect_address.empty() ) ALGO = AlgorithmPtr( new IslandWorker( connect_address ) );
+		else if( num_processes > 1 ) ALGO = AlgorithmPtr( new IslandCoordinator( num_processes ) );
+		else if( num_islands > 1 ) ALGO = AlgorithmPtr( new IslandModel( num_islands ) );
+		else ALGO = AlgorithmPtr( Nsga2::create() );
 
 	}else{
 	 	
@@ -118,7 +198,34 @@ void parse_input_parameters( int argc, char *argv[] ){
 			(option == "--output")			||
 			(option == "--initialsize") 	||
 			(option == "--lparameter") 		||
-			(option == "--evaluations")			
+			(option == "--evaluations")		||
+			(option == "--steadystate")		||
+			(option == "--threads")			||
+			(option == "--islands")			||
+			(option == "--migration")		||
+			(option == "--migrants")		||
+			(option == "--processes")		||
+			(option == "--listen")			||
+			(option == "--connect")			||
+			(option == "--checkpoint")		||
+			(option == "--resume")			||
+			(option == "--hvepsilon")		||
+			(option == "--hvwindow")		||
+			(option == "--archive")			||
+			(option == "--archivegrid")		||
+			(option == "--initialisation")	||
+			(option == "--minibatch")		||
+			(option == "--labels")			||
+			(option == "--frequency")		||
+			(option == "--selection")		||
+			(option == "--estimate")		||
+			(option == "--memory-limit")	||
+			(option == "--runs")			||
+			(option == "--seeds")			||
+			(option == "--jobs")			||
+			(option == "--batch")			||
+			(option == "--serve")			||
+			(option == "--cache")
 		)){
 
 			show_usage( string( argv[0] ) );
@@ -144,7 +251,7 @@ void parse_input_parameters( int argc, char *argv[] ){
 			// Read option value (convert to lowercase)
 			string value = argv[ ++i ];
 
-			if(  (option != "--output") && (option != "--file") ){ // Case of input and output filenames is not affected
+			if(  (option != "--output") && (option != "--file") && (option != "--listen") && (option != "--connect") && (option != "--runs") && (option != "--batch") && (option != "--serve") ){ // Case of filenames and addresses is not affected
 
 				std::transform( value.begin(), value.end(), value.begin(), ::tolower );
 
@@ -157,56 +264,54 @@ void parse_input_parameters( int argc, char *argv[] ){
 
 			}       	
 
-			// --seed option
-			if( (option == "--seed") ){
+			// --algorithm option 
+			if( (option == "--algorithm") ){
 
-				// Seed for random numbers
-				seed = stoul( value );
+				// Input data file
+				algorithm_name = value;
 				continue;
 
 			}
 
-			// --lparameter option
-			if( (option == "--lparameter") ){
+			// --islands option 
+			if( (option == "--islands") ){
 
-				// L parameter
-				mock_L = stoi( value );
+				// Number of islands
+				num_islands = stoi( value );
 				continue;
 
 			}
 
-			// --kmax option
-			if( (option == "--kmax") ){
+			// --processes option 
+			if( (option == "--processes") ){
 
-				// Kuser parameter
-				mock_Kmax = stoi( value );
+				// Number of island processes
+				num_processes = stoi( value );
 				continue;
 
 			}
 
-			// --initialsize option
-			if( (option == "--initialsize") ){
+			// --connect option 
+			if( (option == "--connect") ){
 
-				// Number of solutions to be generated during initialisation
-				TOTAL_INITIAL_SOLUTIONS = stoi( value );
+				// Address of the island coordinator
+				connect_address = value;
 				continue;
 
 			}
 
-			// --algorithm option 
-			if( (option == "--algorithm") ){
+			// --estimate option 
+			if( (option == "--estimate") ){
 
-				// Input data file
-				algorithm_name = value;
+				// Memory footprint estimate only
+				estimate_memory = ( value == "true" || value == "t" || value == "1" );
 				continue;
 
 			}
 
-			// Add tuple to global list of input parameters
-			input_parameters.resize( input_parameters.size()+1 );	
-			input_parameters.back().resize( 2 );	
-			input_parameters.back()[ 0 ] = option;
-			input_parameters.back()[ 1 ] = value;
+			// Context settings (--seed, --lparameter, --kmax, --initialsize), or 
+			// add tuple to global list of input parameters
+			Context::current()->set( option, value );
 
 		}
 
@@ -240,6 +345,56 @@ void show_usage( string program_name ){
 		<< "      --output          Path and/or a prefix for"
 		<< " the name of the output files\n"        	
 		<< "      --seed            Seed for the random numbers generator\n\n"        	
+		<< "      --steadystate     Asynchronous steady-state variant: { true, false }\n\n"        	
+		<< "      --threads         Number of threads generating offspring (evaluating"
+		<< " offspring, in the steady-state variant; 0: all cores)\n\n"        	
+		<< "      --islands         Number of islands (populations evolved"
+		<< " on separate threads)\n\n"        	
+		<< "      --migration       Generations between migrations (island model)\n\n"        	
+		<< "      --migrants        Number of rank-1 individuals sent"
+		<< " per migration (island model)\n\n"        	
+		<< "      --processes       Number of islands evolved in"
+		<< " separate processes (island model)\n\n"        	
+		<< "      --listen          Coordinator address for island processes"
+		<< " started elsewhere: { unix:<path>, tcp:<port> }\n\n"        	
+		<< "      --connect         Run as island process of the given"
+		<< " coordinator: { unix:<path>, tcp:<host>:<port> }\n\n"        	
+		<< "      --checkpoint      Write a checkpoint every given number of"
+		<< " generations (and on SIGTERM/SIGINT)\n\n"        	
+		<< "      --resume          Resume the search from the latest checkpoint: { true, false }\n\n"        	
+		<< "      --hvepsilon       Stop when the relative hypervolume gain of the"
+		<< " rank-1 solutions is below this value...\n\n"        	
+		<< "      --hvwindow        ... over this number of generations (default: 10)\n\n"        	
+		<< "      --archive         Keep an external archive of (at most) this number of"
+		<< " nondominated solutions, reported along with the final population\n\n"        	
+		<< "      --archivegrid     Relative box size of the archive's grid (epsilon-dominance,"
+		<< " fraction of the initial ranges; default: 0, no grid)\n\n"        	
+		<< "      --initialisation  Initial solutions: { priority (MST cuts, default), kmeans,"
+		<< " kmedoids, hybrid (priority or kmeans with equal probability) }\n\n"        	
+		<< "      --minibatch       Mini-batch size of k-means (large data sets; default: 0,"
+		<< " full Lloyd iterations)\n\n"        	
+		<< "      --frequency       Report the rank-1 solutions every given number of generations"
+		<< " (<output>_gen<g>_*, written in the background; default: 0, only at the end)\n\n"        	
+		<< "      --selection       Rank the reported solutions by knee and silhouette"
+		<< " (<output>_model_selection.txt): { true, false }\n\n"        	
+		<< "      --labels          Output of cluster labels: { files (one per solution, default),"
+		<< " binary, csvgz (single matrix, one row per solution) }\n\n"        	
+		<< "      --estimate        Only estimate the memory footprint of each structure"
+		<< " from the data file header and the settings: { true, false (default) }\n\n"        	
+		<< "      --memory-limit    Memory available to the run (bytes, or e.g. 512m, 8g; 0: no limit;"
+		<< " default: physical memory); structures are stored compactly if needed to fit\n\n"        	
+		<< "      --runs            Multi-run mode: file of run configurations, one per line"
+		<< " (options and values, e.g. --delta 90 --lparameter 20); the data are loaded"
+		<< " and pre-computed once for all runs (<output>_run<k>_*, <output>_runs.txt)\n\n"        	
+		<< "      --seeds           Multi-run mode: seeds of each configuration (e.g. 1-30, or 1,5,9)\n\n"        	
+		<< "      --jobs            Multi-run, batch and service modes: number of runs at a time (default: 0, all cores)\n\n"        	
+		<< "      --batch           Batch mode: directory of data sets, or file listing one data file per line;"
+		<< " one run per data set, largest first, while the estimated footprint of the runs in progress"
+		<< " fits within --memory-limit (<output>_<data set>_*, <output>_batch.txt)\n\n"        	
+		<< "      --serve           Service mode: socket address (unix:<path>, or tcp:<port> on localhost)"
+		<< " of the HTTP service; POST /cluster with options one per line (--file, or --data"
+		<< " followed by the data) replies the rank-1 solutions as JSON\n\n"        	
+		<< "      --cache           Service mode: number of data sets kept pre-computed (default: 4)\n\n"        	
 		<< "\n****************************************"
 		<< "****************************************\n"
 		<< std::endl;
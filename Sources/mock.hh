@@ -31,6 +31,12 @@ Dependencies
 ******************/
 #include "mock_Global.hh"
 #include "mock_Nsga2.hh"
+#include "mock_IslandModel.hh"
+#include "mock_ProcessIslands.hh"
+#include "mock_MultiRun.hh"
+#include "mock_Batch.hh"
+#include "mock_Service.hh"
+#include "mock_Memory.hh"
 
 /******************
 Prototypes
@@ -44,18 +50,12 @@ void clean_memory();
 /******************
 Global variables
 ******************/
-vector< vector< string > > input_parameters(0);	// List of command-line parameters
-ClusteringProblemPtr PROBLEM;					// Pointer to PROBLEM object
-AlgorithmPtr ALGO;								// Pointer to ALGORITHM object
+// NOTE: parameters, problem, algorithm and random numbers generator are those of the default 
+// context of the process (mock_Context.hh)
 string algorithm_name;							// Optimization algorithm identifier
-
-default_random_engine *rnd;						// Random numbers generator
-unsigned long int seed = 0;						// Seed for the random numbers generator
-
-// Mock-specific parameters
-int mock_L = 10;							// Number of nearest neighbours to use in mutation and connectivity computation
-int mock_Kmax = -1;							// Upper bound on the number of clusters k generated by k-means during initialisation
-const int num_objectives = 2;				// Number of optimisation objectives to use	
-int TOTAL_INITIAL_SOLUTIONS = -1;			// Size of the initial set of solutions
+int num_islands = 1;							// Number of islands (island model if > 1)
+int num_processes = 1;							// Number of island processes (multi-process island model if > 1)
+string connect_address;							// Address of the island coordinator (worker process)
+bool estimate_memory = false;					// Only estimate the memory footprint (no search)?
 
 #endif
@@ -0,0 +1,321 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Archive.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+ParetoArchive::ParetoArchive( int max_size, string representation, double epsilon ) :
+	_max_size( max_size ),
+	_representation( representation ),
+	_epsilon( epsilon )
+{
+
+	_origin[ 0 ] = _origin[ 1 ] = 0.0;
+	_box[ 0 ] = _box[ 1 ] = 1.0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Grid origin: best value of each objective in the given population
+// Box size: epsilon times the range of each objective (or its magnitude if all values are equal)
+void ParetoArchive::set_grid( PopulationPtr pop ){
+
+	if( _epsilon <= 0.0 || pop->size() == 0 ) return;
+
+	for( int m = 0; m < 2; m++ ){
+
+		double low = (*pop)[ 0 ]->objective( m ), high = low;
+
+		for( int i = 1; i < pop->size(); i++ ){
+
+			low = min( low, (*pop)[ i ]->objective( m ) );
+			high = max( high, (*pop)[ i ]->objective( m ) );
+
+		}
+
+		double range = ( high > low ) ? high - low : max( fabs( high ), 1.0 );
+		_origin[ m ] = low;
+		_box[ m ] = _epsilon * range;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Keys used to compare solutions: objective values, or box indices when a grid is used
+void ParetoArchive::keys( SolutionPtr sol, double & key0, double & key1 ){
+
+	if( _epsilon > 0.0 ){
+
+		key0 = floor( ( sol->objective( 0 ) - _origin[ 0 ] ) / _box[ 0 ] );
+		key1 = floor( ( sol->objective( 1 ) - _origin[ 1 ] ) / _box[ 1 ] );
+
+	}else{
+
+		key0 = sol->objective( 0 );
+		key1 = sol->objective( 1 );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Compact genotype:
+// - split: one bit per relevant MST edge
+// - locus/short: (position, value) pairs for the positions differing from the MST
+void ParetoArchive::compress( SolutionPtr sol, vector< uint32_t > & genotype ){
+
+	int length = sol->encoding_length();
+	genotype.clear();
+
+	if( _representation == "split" ){
+
+		genotype.assign( ( length + 31 ) / 32, 0 );
+		for( int i = 0; i < length; i++ ){
+
+			if( (*sol)[ i ] ) genotype[ i / 32 ] |= ( uint32_t( 1 ) << ( i % 32 ) );
+
+		}
+
+		return;
+
+	}
+
+	for( int i = 0; i < length; i++ ){
+
+		int node = ( _representation == "short" ) ? PROBLEM->relevant_edge( i ) : i;
+		if( (*sol)[ i ] != PROBLEM->mst_edge( node ) ){
+
+			genotype.push_back( uint32_t( i ) );
+			genotype.push_back( uint32_t( (*sol)[ i ] ) );
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Restores the full genotype from its compact form
+void ParetoArchive::decompress( const vector< uint32_t > & genotype, SolutionPtr sol ){
+
+	int length = sol->encoding_length();
+
+	if( _representation == "split" ){
+
+		for( int i = 0; i < length; i++ ) (*sol)[ i ] = ( genotype[ i / 32 ] >> ( i % 32 ) ) & 1;
+		return;
+
+	}
+
+	for( int i = 0; i < length; i++ ){
+
+		(*sol)[ i ] = PROBLEM->mst_edge( ( _representation == "short" ) ? PROBLEM->relevant_edge( i ) : i );
+
+	}
+
+	for( int j = 0; j < int( genotype.size() ); j += 2 ) (*sol)[ genotype[ j ] ] = int( genotype[ j + 1 ] );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Members are sorted by their first key, and thus, in descending order of the second key.
+// The solution is dominated (or duplicated) iff its predecessor (the member with the largest
+// first key not greater than its own) has a second key not greater than its own. Otherwise, the
+// members it dominates are those that follow it while their second key is not smaller.
+// With a grid, a solution falling in an occupied box replaces the member only if it dominates
+// it, or if neither dominates the other and it is closer to the box corner
+bool ParetoArchive::insert( SolutionPtr sol ){
+
+	double key0, key1;
+	keys( sol, key0, key1 );
+
+	std::map< double, Entry >::iterator it = _members.upper_bound( key0 );
+
+	if( it != _members.begin() ){
+
+		std::map< double, Entry >::iterator pred = std::prev( it );
+
+		if( pred->second.key1 <= key1 ){
+
+			if( _epsilon <= 0.0 || pred->first != key0 || pred->second.key1 != key1 ) return false;
+
+			// Same box
+			double * f = pred->second.objective;
+			bool dominated = ( f[ 0 ] <= sol->objective( 0 ) && f[ 1 ] <= sol->objective( 1 ) );
+			bool dominates = ( sol->objective( 0 ) <= f[ 0 ] && sol->objective( 1 ) <= f[ 1 ] );
+
+			if( dominated ) return false;
+
+			if( !dominates ){
+
+				double d_member = 0.0, d_sol = 0.0;
+				for( int m = 0; m < 2; m++ ){
+
+					double corner = _origin[ m ] + ( m == 0 ? key0 : key1 ) * _box[ m ];
+					d_member += pow( ( f[ m ] - corner ) / _box[ m ], 2 );
+					d_sol += pow( ( sol->objective( m ) - corner ) / _box[ m ], 2 );
+
+				}
+
+				if( d_sol >= d_member ) return false;
+
+			}
+
+			it = pred;	// The member is replaced below
+
+		}
+
+	}
+
+	// Remove dominated members
+	it = _members.lower_bound( key0 );
+	while( it != _members.end() && it->second.key1 >= key1 ) it = _members.erase( it );
+
+	// Insert copy
+	Entry & entry = _members[ key0 ];
+	entry.key1 = key1;
+	entry.objective[ 0 ] = sol->objective( 0 );
+	entry.objective[ 1 ] = sol->objective( 1 );
+	entry.kclusters = sol->kclusters();
+	compress( sol, entry.genotype );
+
+	if( _max_size > 0 && size() > _max_size ) truncate();
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParetoArchive::insert( PopulationPtr pop ){
+
+	for( int i = 0; i < pop->size(); i++ ) insert( (*pop)[ i ] );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Discards the member with the smallest crowding distance (normalised objectives);
+// this is the only linear-time operation, performed once per insertion into a full archive
+void ParetoArchive::truncate(){
+
+	if( size() < 3 ) return;
+
+	const double * first = _members.begin()->second.objective;
+	const double * last = _members.rbegin()->second.objective;
+	double range[ 2 ] = { last[ 0 ] - first[ 0 ], first[ 1 ] - last[ 1 ] };
+	for( int m = 0; m < 2; m++ ) if( range[ m ] <= 0.0 ) range[ m ] = 1.0;
+
+	std::map< double, Entry >::iterator most_crowded = _members.end();
+	double smallest = 0.0;
+
+	std::map< double, Entry >::iterator prev = _members.begin(), it = std::next( prev );
+	for( std::map< double, Entry >::iterator next = std::next( it ); next != _members.end(); prev = it, it = next, ++next ){
+
+		double distance = 0.0;
+		for( int m = 0; m < 2; m++ ){
+
+			distance += fabs( next->second.objective[ m ] - prev->second.objective[ m ] ) / range[ m ];
+
+		}
+
+		if( most_crowded == _members.end() || distance < smallest ){
+
+			most_crowded = it;
+			smallest = distance;
+
+		}
+
+	}
+
+	_members.erase( most_crowded );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Decoded members (genotype, objectives and number of clusters)
+void ParetoArchive::members( vector< SolutionPtr > & solutions, std::function< SolutionPtr() > create ){
+
+	solutions.clear();
+
+	for( std::map< double, Entry >::iterator it = _members.begin(); it != _members.end(); ++it ){
+
+		SolutionPtr sol = create();
+		decompress( it->second.genotype, sol );
+		sol->objective( 0 ) = it->second.objective[ 0 ];
+		sol->objective( 1 ) = it->second.objective[ 1 ];
+		sol->kclusters() = it->second.kclusters;
+		sol->rank() = 1;
+		solutions.push_back( sol );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Archive state (grid and members, in compact form)
+void ParetoArchive::put( Checkpoint & checkpoint ){
+
+	for( int m = 0; m < 2; m++ ){
+
+		checkpoint.put< double >( _origin[ m ] );
+		checkpoint.put< double >( _box[ m ] );
+
+	}
+
+	checkpoint.put< int32_t >( size() );
+
+	for( std::map< double, Entry >::iterator it = _members.begin(); it != _members.end(); ++it ){
+
+		checkpoint.put< double >( it->first );
+		checkpoint.put< double >( it->second.key1 );
+		checkpoint.put< double >( it->second.objective[ 0 ] );
+		checkpoint.put< double >( it->second.objective[ 1 ] );
+		checkpoint.put< int32_t >( it->second.kclusters );
+		checkpoint.put< int32_t >( int( it->second.genotype.size() ) );
+		for( int j = 0; j < int( it->second.genotype.size() ); j++ ) checkpoint.put< uint32_t >( it->second.genotype[ j ] );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void ParetoArchive::get( Checkpoint & checkpoint ){
+
+	for( int m = 0; m < 2; m++ ){
+
+		_origin[ m ] = checkpoint.get< double >();
+		_box[ m ] = checkpoint.get< double >();
+
+	}
+
+	_members.clear();
+	int n = checkpoint.get< int32_t >();
+
+	for( int i = 0; i < n; i++ ){
+
+		double key0 = checkpoint.get< double >();
+		Entry & entry = _members[ key0 ];
+		entry.key1 = checkpoint.get< double >();
+		entry.objective[ 0 ] = checkpoint.get< double >();
+		entry.objective[ 1 ] = checkpoint.get< double >();
+		entry.kclusters = checkpoint.get< int32_t >();
+		entry.genotype.resize( checkpoint.get< int32_t >() );
+		for( int j = 0; j < int( entry.genotype.size() ); j++ ) entry.genotype[ j ] = checkpoint.get< uint32_t >();
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,117 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_ARCHIVE_HH__
+#define __MOCK_ARCHIVE_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Archive.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Population.hh"
+#include "mock_Checkpoint.hh"
+#include <map>
+#include <functional>
+
+/******************
+Class definition
+******************/
+
+// Bounded external archive of nondominated solutions (two objectives, minimisation)
+// Members are kept in a balanced search tree ordered by the first objective; since they are
+// mutually nondominated, the second objective is then in descending order. Thus, checking
+// whether a solution is dominated requires a single O(log n) lookup (its predecessor), and the
+// members it dominates are its (contiguous) successors. 
+// Optionally, objective space is divided in a grid (epsilon-dominance): solutions are compared
+// by their boxes, and at most one solution is kept per box (the closest to the box corner).
+// When the maximum size is exceeded, the most crowded member is discarded (extremes are kept).
+// Genotypes are stored compactly: a bit per position (split representation), or the list of
+// positions differing from the MST (locus and short representations)
+class ParetoArchive{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		// Archived solution
+		struct Entry{
+
+			double key1;					// Second key (objective value, or box)
+			double objective[ 2 ];			// Objective values
+			int kclusters;					// Number of clusters
+			vector< uint32_t > genotype;	// Compact genotype
+
+		};
+
+		std::map< double, Entry > _members;		// Members, by first key (objective value, or box)
+
+		int _max_size;							// Maximum number of members
+
+		string _representation;					// Encoding of the archived solutions
+
+		double _epsilon;						// Relative box size (0: no grid)
+
+		double _origin[ 2 ];					// Grid origin and box size
+		double _box[ 2 ];						// (defined by the ranges of the initial solutions)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		void keys( SolutionPtr sol, double & key0, double & key1 );
+		void compress( SolutionPtr sol, vector< uint32_t > & genotype );
+		void decompress( const vector< uint32_t > & genotype, SolutionPtr sol );
+		void truncate();
+
+	public:
+
+		// Constructor
+		ParetoArchive( int max_size, string representation, double epsilon = 0.0 );
+
+		// Grid origin and box size, based on the ranges of the objectives in the given population
+		void set_grid( PopulationPtr pop );
+
+		// Insert a copy of the solution unless it is dominated (true if archived)
+		bool insert( SolutionPtr sol );
+		void insert( PopulationPtr pop );
+
+		// Number of members
+		int size(){ return int( _members.size() ); }
+
+		// Decoded members, in ascending order of the first objective (caller takes ownership)
+		void members( vector< SolutionPtr > & solutions, std::function< SolutionPtr() > create );
+
+		// Checkpoint/restart
+		void put( Checkpoint & checkpoint );
+		void get( Checkpoint & checkpoint );
+
+};
+
+#endif
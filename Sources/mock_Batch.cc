@@ -0,0 +1,370 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+
+#include "mock_Batch.hh"
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <condition_variable>
+#include <dirent.h>
+#include <sys/stat.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+Batch::Batch() : 
+
+	Algorithm( "batch" )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+Batch::~Batch(){}
+////////////////////////////////////////////////////////////////////////////////
+// Batch mode requested? (--batch)
+bool Batch::enabled(){
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--batch" ) return true;
+
+	}
+
+	return false;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void Batch::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_jobs = 0;
+	_batch_path = "";
+	_out_filename = "";
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--batch") ){
+
+			// Directory of data sets, or manifest file
+			_batch_path = value;
+
+		}else if( (option == "--jobs") ){
+
+			// Maximum number of runs at a time
+			_jobs = stoi( value );
+
+		}else if( (option == "--output") ){
+
+			// Output filename
+			_out_filename = value;
+
+		}
+
+	}
+
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configures search algorithm: data sets (largest first) and settings of their runs
+void Batch::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _jobs <= 0 ) _jobs = ThreadPool::default_threads();
+	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
+
+	_limit = Memory::limit();
+
+	// Settings common to all runs: command-line options (runs are single-threaded by default)
+	_common = { { "--threads", "1" } };
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		string option = input_parameters[ i ][ 0 ];
+		if( option == "--batch" || option == "--jobs" || option == "--output" || option == "--file" ) continue;
+
+		_common.push_back( { option, input_parameters[ i ][ 1 ] } );
+
+	}
+	_common.push_back( { "--seed", to_string( Context::current()->seed ) } );
+	_common.push_back( { "--lparameter", to_string( mock_L ) } );
+	_common.push_back( { "--kmax", to_string( mock_Kmax ) } );
+	_common.push_back( { "--initialsize", to_string( TOTAL_INITIAL_SOLUTIONS ) } );
+
+	// Data sets: size from the data file header, footprint under the storage plan of a run
+	vector< string > filenames;
+	read_filenames( filenames );
+
+	std::map< string, int > prefixes;
+	for( const string & filename : filenames ){
+
+		Dataset dataset;
+		dataset.filename = filename;
+		dataset.time = 0.0;
+
+		if( !Memory::header( filename, dataset.ndata, dataset.mdim ) ){
+
+			cerr << "WARNING: skipping " << filename << " (unreadable, or invalid header)" << endl;
+			continue;
+
+		}
+
+		dataset.footprint = Memory::plan( dataset.ndata, dataset.mdim, 1 ).footprint;
+
+		if( _limit > 0 && dataset.footprint > _limit ){
+
+			cerr << "WARNING: the estimated footprint of " << filename << " exceeds the memory limit (it will run alone)" << endl;
+
+		}
+
+		// Output files named after the data file (without directory and extension)
+		string name = filename.substr( filename.find_last_of( '/' ) + 1 );
+		if( name.find( '.' ) != string::npos && name.find( '.' ) > 0 ) name = name.substr( 0, name.find_last_of( '.' ) );
+		int & count = prefixes[ name ];
+		if( ++count > 1 ) name += "_" + to_string( count );
+		dataset.prefix = _out_filename + "_" + name;
+
+		_datasets.push_back( dataset );
+
+	}
+
+	if( _datasets.empty() ) error_message_exit( "No data sets were found (--batch): " + _batch_path );
+
+	// Largest first (ties: in the order given)
+	std::stable_sort( _datasets.begin(), _datasets.end(), []( const Dataset & a, const Dataset & b ){ return a.footprint > b.footprint; } );
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\t\t" << _datasets.size() << " data sets (" << _jobs << " runs at a time)" << endl;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Data files: regular files of the directory (except hidden ones, in name order), or one path
+// per line of the manifest file (blank lines and lines starting with '#' are ignored)
+void Batch::read_filenames( vector< string > & filenames ){
+
+	filenames.clear();
+
+	struct stat status;
+	if( stat( _batch_path.c_str(), &status ) != 0 ) error_message_exit( "Error while trying to open file: " + _batch_path );
+
+	if( S_ISDIR( status.st_mode ) ){
+
+		DIR * directory = opendir( _batch_path.c_str() );
+		if( directory == nullptr ) error_message_exit( "Error while trying to open directory: " + _batch_path );
+
+		string path = _batch_path + ( _batch_path.back() == '/' ? "" : "/" );
+		while( struct dirent * entry = readdir( directory ) ){
+
+			string filename = path + entry->d_name;
+			if( entry->d_name[ 0 ] == '.' || stat( filename.c_str(), &status ) != 0 || !S_ISREG( status.st_mode ) ) continue;
+
+			filenames.push_back( filename );
+
+		}
+		closedir( directory );
+
+		std::sort( filenames.begin(), filenames.end() );
+
+	}else{
+
+		ifstream input( _batch_path );
+		if( !input ) error_message_exit( "Error while trying to open file: " + _batch_path );
+
+		string line;
+		while( std::getline( input, line ) ){
+
+			// Paths may contain spaces: only leading and trailing blanks are removed
+			size_t first = line.find_first_not_of( " \t\r" );
+			if( first == string::npos || line[ first ] == '#' ) continue;
+
+			filenames.push_back( line.substr( first, line.find_last_not_of( " \t\r" ) - first + 1 ) );
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Parameters of the run of a data set: common settings, data file and output files
+vector< std::pair< string, string > > Batch::parameters( const Dataset & dataset ){
+
+	vector< std::pair< string, string > > run = _common;
+	run.push_back( { "--file", dataset.filename } );
+	run.push_back( { "--output", dataset.prefix } );
+
+	return run;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Order of the runs: data sets with their size and estimated footprint, largest first
+void Batch::schedule( std::ostream & out ){
+
+	out << std::fixed << std::setprecision( 1 );
+	out << "Batch of " << _datasets.size() << " data sets, largest first (" << _jobs << " runs at a time";
+	if( _limit > 0 ) out << ", memory limit " << _limit / 1048576.0 << " MB";
+	out << ")" << endl;
+
+	for( const Dataset & dataset : _datasets ){
+
+		out << "\t" << dataset.filename << "\tN = " << dataset.ndata << ", d = " << dataset.mdim << "\t" << dataset.footprint / 1048576.0 << " MB" << endl;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine: starts the largest pending data set that fits within the memory 
+// limit whenever fewer than --jobs runs are in progress (any, if none is in progress)
+// Each finished run is added to <output>_batch.txt (data file, N, d, estimated footprint 
+// in MB and wall-clock time in seconds)
+void Batch::run(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Running " << _datasets.size() << " data sets (" << _jobs << " at a time)" << endl;
+	#endif
+
+	PROFILE_PHASE( "batch" );
+
+	const int n = int( _datasets.size() );
+	std::mutex mutex;
+	std::condition_variable finished_run;
+	vector< bool > started( n, false );
+	int running = 0, finished = 0;
+	long long reserved = 0;
+
+	string filename = _out_filename + "_batch.txt";
+	ofstream list( filename );
+	if( !list ) error_message_exit( "Error while trying to open file: " + filename );
+	list << std::fixed << std::setprecision( 1 );
+
+	std::chrono::steady_clock::time_point batch_start = std::chrono::steady_clock::now();
+	auto elapsed = [ &batch_start ](){ return std::chrono::duration< double >( std::chrono::steady_clock::now() - batch_start ).count(); };
+
+	ThreadPool pool( min( _jobs, n ) );
+	for( int launched = 0; launched < n; launched++ ){
+
+		std::unique_lock< std::mutex > lock( mutex );
+
+		int k = -1;
+		finished_run.wait( lock, [ & ](){
+
+			if( running >= _jobs ) return false;
+
+			for( int i = 0; i < n; i++ ){
+
+				if( started[ i ] ) continue;
+				if( running == 0 || _limit <= 0 || reserved + _datasets[ i ].footprint <= _limit ){ k = i; return true; }
+
+			}
+
+			return false;
+
+		});
+
+		started[ k ] = true;
+		running++;
+		reserved += _datasets[ k ].footprint;
+
+		#ifdef DISPLAY_PROGRESS_MESSAGES
+			std::ostringstream message;
+			message << std::fixed << std::setprecision( 1 ) << "[" << elapsed() << " s] Started " << _datasets[ k ].filename 
+				<< " (" << _datasets[ k ].footprint / 1048576.0 << " MB; " << running << " running, " << reserved / 1048576.0 << " MB)\n";
+			cout << message.str() << std::flush;
+		#endif
+
+		lock.unlock();
+
+		pool.submit( [ this, k, n, &mutex, &finished_run, &running, &finished, &reserved, &list, &elapsed ]( int worker ){
+
+			Dataset & dataset = _datasets[ k ];
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			{
+
+				Job job( parameters( dataset ) );
+				job.run();
+				job.write();
+
+			}
+
+			dataset.time = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+			std::lock_guard< std::mutex > lock( mutex );
+
+			running--;
+			reserved -= dataset.footprint;
+			finished++;
+
+			list << dataset.filename << "\t" << dataset.ndata << "\t" << dataset.mdim << "\t" << dataset.footprint / 1048576.0 << "\t" << dataset.time << "\n" << std::flush;
+
+			#ifdef DISPLAY_PROGRESS_MESSAGES
+				std::ostringstream message;
+				message << std::fixed << std::setprecision( 1 ) << "[" << elapsed() << " s] Finished " << dataset.filename 
+					<< " (" << finished << "/" << n << ", " << dataset.time << " s)\n";
+				cout << message.str() << std::flush;
+			#endif
+
+			finished_run.notify_all();
+
+		});
+
+	}
+
+	pool.wait();
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tWritten file: " + filename << endl;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reports results: run report of the batch (the list of runs is written as they finish)
+void Batch::generate_output( int g ){
+
+	#if PROFILE_LEVEL > 0
+		Profiler::current().write( _out_filename + "_run_report.json" );
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+
+#ifndef __MOCK_BATCH_HH__
+#define __MOCK_BATCH_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Batch.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Algorithm.hh"
+#include "mock_Job.hh"
+#include "mock_Memory.hh"
+#include "mock_ThreadPool.hh"
+
+/******************
+Class definition
+******************/
+
+// Batch mode: one run per data set (files of a directory, or listed in a manifest file given 
+// by --batch), up to --jobs runs at a time
+// Runs are started largest first (estimated footprint, from N and d in the data file header) 
+// and only while the estimated footprint of the runs in progress stays within the memory limit
+// (--memory-limit, default: the physical memory); smaller data sets fill the remaining room
+// Each run is a Job with its own problem instance and output files (<output>_<data set>_*)
+class Batch : public Algorithm {
+
+	/******************
+	Types
+	******************/
+
+	protected:
+
+		struct Dataset{
+
+			string filename;				// Data file
+			string prefix;					// Output files of its run
+			int ndata;						// Size and dimensionality (data file header)
+			int mdim;
+			long long footprint;			// Estimated memory footprint of its run (bytes)
+			double time;					// Wall-clock time of its run (seconds)
+
+		};
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		vector< Dataset > _datasets;		// Data sets, largest first
+
+		vector< std::pair< string, string > > _common;	// Parameters common to all runs
+
+		int _jobs;							// Maximum number of runs at a time (0: all cores)
+
+		long long _limit;					// Maximum estimated footprint of the runs in progress (0: none)
+
+		string _batch_path;					// Directory of data sets, or manifest file (one data file per line)
+
+		string _out_filename;				// Name of output file(s)
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+		// Data files of the directory, or listed in the manifest file
+		void read_filenames( vector< string > & filenames );
+
+		// Parameters of the run of a data set
+		vector< std::pair< string, string > > parameters( const Dataset & dataset );
+
+	public:
+
+		// Constructor / destructor
+		Batch();
+		virtual ~Batch();
+
+		// Batch mode requested? (--batch)
+		static bool enabled();
+
+		// Order of the runs (--estimate true): data sets with their size and estimated footprint
+		void schedule( std::ostream & out );
+
+		// Main execution routine
+		virtual void run();
+
+		// Output generation (run report; output files of each run are written by the run, 
+		// the list of runs as they finish)
+		virtual void generate_output( int g = -1 );
+
+};
+
+#endif
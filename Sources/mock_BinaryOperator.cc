@@ -27,48 +27,10 @@ Last updated: 10 July 2017
 
 ////////////////////////////////////////////////////////////////////////////////
 // Uniform crossover operator
-// Offspring get each allele from either one or the other parent with equal probability
 // NOTE: Assumes memory of children individuals is already allocated
 void BinaryOperator::uniform_crossover( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2, double prob ){
 
-	// Crossover is applied based on a given probability
-	if( random_real(0, 1) < prob ){
-
-		for( int i = 0; i < parent1->encoding_length(); i++ ){
-
-			// Get allele from parent1 or from parent2?
-			if( random_real(0, 1) < 0.5 ){
-
-				// Child 1 takes i-th allele from Parent 1
-				(*child1)[ i ] = (*parent1)[ i ];
-
-				// Child 2 takes i-th allele from Parent 2
-				(*child2)[ i ] = (*parent2)[ i ];
-
-			}else{
-
-				// Child 1 takes i-th allele from Parent 2
-				(*child1)[ i ] = (*parent2)[ i ];
-
-				// Child 2 takes i-th allele from Parent 1
-				(*child2)[ i ] = (*parent1)[ i ];
-
-			}
-
-		}
-
-	}else{
-
-		// Offspring get exact copies of parents' encoding
-		for( int i = 0; i < parent1->encoding_length(); i++ ){
-
-				(*child1)[ i ] = (*parent1)[ i ];
-				
-				(*child2)[ i ] = (*parent2)[ i ];
-
-		}
-
-	}
+	uniform_crossover( parent1->genes(), parent2->genes(), child1->genes(), child2->genes(), parent1->encoding_length(), prob );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
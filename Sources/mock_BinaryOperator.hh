@@ -60,7 +60,53 @@ class BinaryOperator{
 		// Crossover operators
 		static void uniform_crossover( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2, double const prob );
 
+		// Row-based kernels (used directly by the representation-typed pipeline)
+		static void uniform_crossover( const int * p1, const int * p2, int * c1, int * c2, const int length, double const prob );
+
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Uniform crossover operator
+// Offspring get each allele from either one or the other parent with equal probability
+// Operates directly on the genotype rows; coin flips are taken from 64-bit random words
+inline void BinaryOperator::uniform_crossover( const int * p1, const int * p2, int * c1, int * c2, const int length, double const prob ){
+
+	// Crossover is applied based on a given probability
+	if( rnd->uniform() < prob ){
+
+		uint64_t bits = 0;
+
+		for( int i = 0; i < length; i++ ){
+
+			if( ( i & 63 ) == 0 ) bits = (*rnd)();
+
+			// Get allele from parent1 or from parent2?
+			if( ( bits >> ( i & 63 ) ) & 1 ){
+
+				// Child 1 takes i-th allele from Parent 1, child 2 from Parent 2
+				c1[ i ] = p1[ i ];
+				c2[ i ] = p2[ i ];
+
+			}else{
+
+				// Child 1 takes i-th allele from Parent 2, child 2 from Parent 1
+				c1[ i ] = p2[ i ];
+				c2[ i ] = p1[ i ];
+
+			}
+
+		}
+
+	}else{
+
+		// Offspring get exact copies of parents' encoding
+		std::copy( p1, p1 + length, c1 );
+		std::copy( p2, p2 + length, c2 );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
 #endif
 
@@ -0,0 +1,161 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Checkpoint.hh"
+#include <cstdio>
+
+volatile sig_atomic_t Checkpoint::_signal = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor: opens the checkpoint for reading, or a temporary file for writing
+Checkpoint::Checkpoint( string filename, bool writing ) :
+
+	_filename( filename ),
+	_writing( writing )
+
+{
+
+	if( _writing ){
+
+		_file.open( _filename + ".tmp", ios::out | ios::binary | ios::trunc );
+		if( !_file ) error_message_exit( "Cannot write checkpoint file: " + _filename + ".tmp" );
+
+		put< uint32_t >( MAGIC );
+		put< uint32_t >( VERSION );
+
+	}else{
+
+		_file.open( _filename, ios::in | ios::binary );
+		if( !_file ) error_message_exit( "Cannot read checkpoint file: " + _filename );
+
+		if( get< uint32_t >() != MAGIC || get< uint32_t >() != VERSION ){
+
+			error_message_exit( "Not a (compatible) checkpoint file: " + _filename );
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor (an uncommitted temporary file is discarded)
+Checkpoint::~Checkpoint(){
+
+	if( _file.is_open() ){
+
+		_file.close();
+		if( _writing ) remove( ( _filename + ".tmp" ).c_str() );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Make the new checkpoint the latest one (atomic replacement)
+void Checkpoint::commit(){
+
+	_file.flush();
+	if( !_file ) error_message_exit( "Error writing checkpoint file: " + _filename + ".tmp" );
+	_file.close();
+
+	if( rename( ( _filename + ".tmp" ).c_str(), _filename.c_str() ) != 0 ){
+
+		error_message_exit( "Cannot replace checkpoint file: " + _filename );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes an array of integers
+void Checkpoint::put( const int *values, int n ){
+
+	_file.write( (const char *)( values ), sizeof( int ) * n );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reads an array of integers
+void Checkpoint::get( int *values, int n ){
+
+	_file.read( (char *)( values ), sizeof( int ) * n );
+	if( !_file ) error_message_exit( "Checkpoint file is truncated or corrupted: " + _filename );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes a string (length-prefixed)
+void Checkpoint::put_string( const string & value ){
+
+	put< uint32_t >( uint32_t( value.size() ) );
+	_file.write( value.data(), value.size() );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reads a string (length-prefixed)
+string Checkpoint::get_string(){
+
+	string value( get< uint32_t >(), '\0' );
+	_file.read( &value[ 0 ], value.size() );
+	if( !_file ) error_message_exit( "Checkpoint file is truncated or corrupted: " + _filename );
+	return value;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes genotype, objectives and ranking information of a solution
+void Checkpoint::put_solution( SolutionPtr sol ){
+
+	for( int i = 0; i < sol->encoding_length(); i++ ) put< int32_t >( (*sol)[ i ] );
+	for( int m = 0; m < num_objectives; m++ ) put< double >( sol->objective( m ) );
+	put< int32_t >( sol->kclusters() );
+	put< uint64_t >( sol->evaluation() );
+	put< int32_t >( sol->rank() );
+	put< double >( sol->crowding_distance() );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reads genotype, objectives and ranking information of a solution
+void Checkpoint::get_solution( SolutionPtr sol ){
+
+	for( int i = 0; i < sol->encoding_length(); i++ ) (*sol)[ i ] = get< int32_t >();
+	for( int m = 0; m < num_objectives; m++ ) sol->objective( m ) = get< double >();
+	sol->kclusters() = get< int32_t >();
+	sol->evaluation() = get< uint64_t >();
+	sol->rank() = get< int32_t >();
+	sol->crowding_distance() = get< double >();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Termination signals are recorded; the search writes a checkpoint and stops at the end 
+// of the current generation
+void Checkpoint::install_signal_handlers(){
+
+	signal( SIGTERM, signal_handler );
+	signal( SIGINT, signal_handler );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void Checkpoint::signal_handler( int sig ){
+
+	_signal = sig;
+
+}
+////////////////////////////////////////////////////////////////////////////////
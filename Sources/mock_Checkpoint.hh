@@ -0,0 +1,123 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_CHECKPOINT_HH__
+#define __MOCK_CHECKPOINT_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Checkpoint.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Solution.hh"
+#include <csignal>
+#include <sstream>
+
+/******************
+Class definition
+******************/
+
+// Binary checkpoint file (native byte order)
+// Written to a temporary file which replaces the previous checkpoint only once complete, 
+// so that an interrupted write never corrupts the latest checkpoint. Also keeps track of 
+// termination requests (SIGTERM, SIGINT), upon which a final checkpoint is to be written
+class Checkpoint{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		string _filename;						// Checkpoint file
+
+		bool _writing;							// Opened for writing (otherwise, for reading)?
+
+		fstream _file;							// File stream (temporary file if writing)
+
+		static volatile sig_atomic_t _signal;	// Termination signal received (0: none)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		static void signal_handler( int sig );
+
+	public:
+
+		static const uint32_t MAGIC = 0x4b434d44;	// "DMCK"
+		static const uint32_t VERSION = 4;
+
+		// Constructor / destructor
+		Checkpoint( string filename, bool writing );
+		~Checkpoint();
+
+		// Writing: make the new checkpoint the latest one
+		void commit();
+
+		// Raw values
+		template < typename T > void put( const T value );
+		template < typename T > T get();
+
+		// Arrays, strings
+		void put( const int *values, int n );
+		void get( int *values, int n );
+		void put_string( const string & value );
+		string get_string();
+
+		// Solutions (genotype, objectives and ranking information)
+		void put_solution( SolutionPtr sol );
+		void get_solution( SolutionPtr sol );
+
+		// Termination requests
+		static void install_signal_handlers();
+		static int interrupted(){ return _signal; }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes a raw value
+template < typename T >
+inline void Checkpoint::put( const T value ){
+
+	_file.write( (const char *)( &value ), sizeof( T ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reads a raw value
+template < typename T >
+inline T Checkpoint::get(){
+
+	T value;
+	_file.read( (char *)( &value ), sizeof( T ) );
+	if( !_file ) error_message_exit( "Checkpoint file is truncated or corrupted: " + _filename );
+	return value;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
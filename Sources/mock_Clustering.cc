@@ -31,7 +31,7 @@ Last updated: 10 July 2017
 Clustering::Clustering( VectorIntPtr locus_encoding ){
 
 	// Allocate memory and initialise
-	_cluster_assignment = allocate_VectorInt( PROBLEM->ndata() );
+	_cluster_assignment = allocate_VectorInt( PROBLEM->ndata(), "clustering" );
 	for( int i=0; i<PROBLEM->ndata(); i++ ){ _cluster_assignment[ i ] = -1; }
 	_total_clusters = 0; // Total number of clusters found	
 	int previous[ PROBLEM->ndata() ];
@@ -102,7 +102,7 @@ Clustering::Clustering( VectorIntPtr assignment, const int clusters, bool create
 	if( create_copy ){
 
 		// Allocate memory
-		_cluster_assignment = allocate_VectorInt( PROBLEM->ndata() );
+		_cluster_assignment = allocate_VectorInt( PROBLEM->ndata(), "clustering" );
 
 		// Copy assignment
 		for( int i=0; i<PROBLEM->ndata(); i++ ){
@@ -133,8 +133,8 @@ Clustering::~Clustering(){
 void Clustering::compute_cluster_centres(){	
 
 	// Allocate memory and initialise
-	_centre = allocate_MatrixFloat( _total_clusters, PROBLEM->mdim() );
-	_member_ctr = allocate_VectorInt( _total_clusters );	
+	_centre = allocate_MatrixFloat( _total_clusters, PROBLEM->mdim(), "clustering" );
+	_member_ctr = allocate_VectorInt( _total_clusters, "clustering" );	
 	for( int i=0; i<_total_clusters; i++){	
 
 		for( int j=0; j<PROBLEM->mdim(); j++) _centre[ i ][ j ] = 0.0;
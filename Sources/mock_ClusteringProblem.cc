@@ -24,10 +24,20 @@ Last updated: 10 July 2017
 *******************************************************************************/
 
 #include "mock_ClusteringProblem.hh"
+#include "mock_EvaluatorDelta.hh"
+#include <atomic>
+#include <queue>
+#include <tuple>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
-ClusteringProblem::ClusteringProblem() : 
+// Settings and data are loaded; pre-computations may be deferred (see precompute)
+ClusteringProblem::ClusteringProblem( bool precompute ) : ClusteringProblem( precompute, nullptr ) {}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor of an instance sharing the data and pre-computations of another one (see share)
+ClusteringProblem::ClusteringProblem( ClusteringProblemPtr shared ) : ClusteringProblem( true, shared ) {}
+////////////////////////////////////////////////////////////////////////////////
+ClusteringProblem::ClusteringProblem( bool precompute, ClusteringProblemPtr shared ) : 
 
 	_data( nullptr ),
 	_filename( "" ), 
@@ -38,35 +48,71 @@ ClusteringProblem::ClusteringProblem() :
 	_num_real_clusters( -1 ),
 	_normalise( true ),
 	_distance_matrix( nullptr ),
+	_min_distance( 0.0 ),
+	_max_distance( 0.0 ),
 	_nearest_neighbours( nullptr ),
+	_num_neighbours( 0 ),
+	_neighbour_rank( nullptr ),
+	_mst_rank( nullptr ),
+	_priority_edges( nullptr ),
+	_relevant_edges( nullptr ),
+	_mst( nullptr ),
+	_fixed_edges( nullptr ),
+	_is_fixed( nullptr ),
+	_relevant_index( nullptr ),
     _distance( "" ),
-    _delta( 0 )
+    _delta( 0 ),
+    _precomputed_assignment( nullptr ),
+    _shared( shared )
 
 {
 
+	static std::atomic< uint64_t > instances( 0 );
+	_instance = ++instances;
+
 	initialise();
 
+	if( _shared != nullptr ) share();
+	else{
+
+		configure();
+		if( precompute ) this->precompute();
+
+	}
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Destructor
 ClusteringProblem::~ClusteringProblem(){
 
+	// Structures of the shared instance are not released
+	if( _shared != nullptr ){
+
+		_data = nullptr;
+		_label = nullptr;
+		_distance_matrix = nullptr;
+		_nearest_neighbours = nullptr;
+		_neighbour_rank = nullptr;
+
+	}
+
 	deallocate_MatrixFloat( _data, _ndata );
 	deallocate_VectorInt( _label ); 
     deallocate_MatrixFloat( _distance_matrix, _ndata );
     deallocate_MatrixInt( _nearest_neighbours, _ndata );
 	deallocate_MatrixInt( _neighbour_rank, _ndata );
+    deallocate_VectorInt( _mst_rank );
     deallocate_VectorInt( _mst );
     deallocate_VectorDouble( _priority_edges );
     deallocate_VectorInt( _relevant_edges );
     delete[] _is_fixed;
     deallocate_VectorInt( _fixed_edges );    
     deallocate_VectorInt( _relevant_index );
+    delete _precomputed_assignment;
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Initialises based on command-line input parameters
-// and invokes configuration of problem
 void ClusteringProblem::initialise(){
 
 	#ifdef DISPLAY_PROGRESS_MESSAGES
@@ -107,13 +153,9 @@ void ClusteringProblem::initialise(){
 	// Validate that required attributes were correctly set
 	if( _filename.empty() ) error_message_exit( "-f,--filename option was not correctly set!" );
 
-	// Load data and configure
-	configure();
-
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Loads data and configure problem 
-// Invokes pre-computations required
 void ClusteringProblem::configure(){
 
 	#ifdef DISPLAY_PROGRESS_MESSAGES
@@ -121,16 +163,92 @@ void ClusteringProblem::configure(){
 	#endif
 
 	// Load and prepare data
-	load_data();
+	{
+		PROFILE_PHASE( "load_data" );
+		load_data();
+	}
+
+	// Storage strategy of the pre-computed structures (within the memory limit)
+	_plan = Memory::plan( _ndata, _mdim, 1 );
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\t\tStorage plan: " << _plan.describe() << " (estimated " << _plan.footprint / 1048576 << " MB";
+		if( _plan.limit > 0 ) cout << " of " << _plan.limit / 1048576 << " MB";
+		cout << ")" << endl;
+	#endif
+
+	if( _plan.limit > 0 && _plan.footprint > _plan.limit ){
+		cerr << "WARNING: the estimated memory footprint (" << _plan.footprint / 1048576 << " MB) exceeds the memory limit (" << _plan.limit / 1048576 << " MB), even with the most compact storage" << endl;
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Pre-computations required: distance matrix, nearest neighbours and MST
+// (computed once)
+void ClusteringProblem::precompute(){
+
+	if( _mst != nullptr ) return;
 
     // Pre-computation of distance matrix
-    compute_distance_matrix(); 
+    {
+        PROFILE_PHASE( "distance_matrix" );
+        compute_distance_matrix(); 
+    }
 
     // Pre-computation of nearest neighbours
-    compute_nearest_neighbours();
+    {
+        PROFILE_PHASE( "nearest_neighbours" );
+        compute_nearest_neighbours();
+    }
 
     // Pre-computation of the minimum spanning tree (MST)
-    compute_mst();
+    {
+        PROFILE_PHASE( "mst" );
+        compute_mst();
+    }
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Adopts the data, distances and nearest neighbours of the shared instance (loaded and 
+// pre-computed, same data set), which must outlive this one
+// The MST is re-oriented from a random root, as computed by this instance's own Prim's method; 
+// structures depending on delta (relevant edges, pre-computed assignment) are this instance's own
+void ClusteringProblem::share(){
+
+	if( _filename != _shared->_filename || _normalise != _shared->_normalise ){
+
+		error_message_exit( "Instances sharing pre-computations must use the same data set (--file, --normalise)" );
+
+	}
+
+	_ndata = _shared->_ndata;
+	_mdim = _shared->_mdim;
+	_data = _shared->_data;
+	_labels_provided = _shared->_labels_provided;
+	_label = _shared->_label;
+	_num_real_clusters = _shared->_num_real_clusters;
+	_distance = _shared->_distance;
+	distance_measure = _shared->distance_measure;
+
+	_plan = _shared->_plan;
+	_distance_matrix = _shared->_distance_matrix;
+	_min_distance = _shared->_min_distance;
+	_max_distance = _shared->_max_distance;
+	_nearest_neighbours = _shared->_nearest_neighbours;
+	_num_neighbours = _shared->_num_neighbours;
+	_neighbour_rank = _shared->_neighbour_rank;
+
+	// Stored neighbour lists (if not full) must cover the L nearest neighbours
+	if( !_plan.full_neighbours && mock_L >= _num_neighbours ){
+
+		error_message_exit( "The shared nearest neighbour lists are shorter than L (--lparameter)" );
+
+	}
+
+    {
+        PROFILE_PHASE( "mst" );
+        orient_mst();
+    }
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -160,8 +278,8 @@ void ClusteringProblem::load_data(){
     input >> _num_real_clusters;
 
     // Allocate memory for data
-    _data = allocate_MatrixFloat( _ndata, _mdim );
-    if( _labels_provided ) _label = allocate_VectorInt( _ndata );
+    _data = allocate_MatrixFloat( _ndata, _mdim, "data" );
+    if( _labels_provided ) _label = allocate_VectorInt( _ndata, "data" );
 
     // Allocate memory for Min, Max, Avg, and Std, and initialise
     VectorFloatPtr _maximum = allocate_VectorFloat( _mdim );
@@ -307,17 +425,39 @@ void ClusteringProblem::compute_distance_matrix(){
         error_message_exit( "Undefined distance measure!" );
     #endif
 
+    // Without the matrix, only min and max values are computed (distances normalised on demand)
+    if( !_plan.dense_distances ){
+
+        _min_distance = INF;
+        _max_distance = -INF;
+
+        for( int i=0; i<_ndata; i++ ){
+
+            for( int j=i+1; j<_ndata; j++ ){
+
+                float dist = (*distance_measure)( _data[ i ], _data[ j ], _mdim );
+                if( dist > _max_distance ) _max_distance = dist;
+                if( dist < _min_distance ) _min_distance = dist;
+
+            }
+
+        }
+
+        return;
+
+    }
+
     // Allocate memory - LOWER TRIANGULAR MATRIX (include diagonal)
-    _distance_matrix = MatrixFloatPtr( new VectorFloatPtr [ _ndata ] );
+    _distance_matrix = MatrixFloatPtr( allocate_tracked( size_t( _ndata ) * sizeof( VectorFloatPtr ), "distance_matrix" ) );
     for( int i=0; i<_ndata; i++){
 
-        _distance_matrix[ i ] = allocate_VectorFloat( i+1 );
+        _distance_matrix[ i ] = allocate_VectorFloat( i+1, "distance_matrix" );
 
     }
 
     // Compute distance matrix, and min, max, avg values
-    float _min_distance = INF;     
-    float _max_distance = -INF;    
+    _min_distance = INF;     
+    _max_distance = -INF;    
     // float _avg_distance = 0.0; 
 
     for( int i=0; i<_ndata; i++ ){   
@@ -360,11 +500,45 @@ void ClusteringProblem::compute_nearest_neighbours(){
         cout << "\t\tPre-computing nearest neighbours" << endl;
     #endif
 
+    // Only the L nearest neighbours are kept (partial sort, ties broken by index)
+    if( !_plan.full_neighbours ){
+
+        _num_neighbours = min( _ndata, mock_L + 1 );
+        _nearest_neighbours = allocate_MatrixInt( _ndata, _num_neighbours, "nearest_neighbours" );
+        VectorFloatPtr dist = allocate_VectorFloat( _ndata, "nearest_neighbours" );
+        VectorIntPtr order = allocate_VectorInt( _ndata, "nearest_neighbours" );
+
+        for( int i=0; i<_ndata; i++ ){
+
+            for( int j=0; j<_ndata; j++ ){
+
+                dist[ j ] = distance( i, j );
+                order[ j ] = j;
+
+            }
+
+            // i is the closest neighbour of i
+            std::swap( order[ 0 ], order[ i ] );
+            std::partial_sort( order + 1, order + _num_neighbours, order + _ndata, [ dist ]( int a, int b ){ 
+                return ( dist[ a ] < dist[ b ] ) || ( dist[ a ] == dist[ b ] && a < b ); 
+            } );
+
+            std::copy( order, order + _num_neighbours, _nearest_neighbours[ i ] );
+
+        }
+
+        deallocate_VectorFloat( dist );
+        deallocate_VectorInt( order );
+        return;
+
+    }
+
     // Allocate memory
     int size = _ndata-1;
-    _nearest_neighbours = allocate_MatrixInt( _ndata, _ndata );
-    _neighbour_rank = allocate_MatrixInt( _ndata, _ndata );
-    VectorDoublePtr idx_val_tuples = allocate_VectorDouble( 2*size );
+    _num_neighbours = _ndata;
+    _nearest_neighbours = allocate_MatrixInt( _ndata, _ndata, "nearest_neighbours" );
+    _neighbour_rank = allocate_MatrixInt( _ndata, _ndata, "neighbour_rank" );
+    VectorDoublePtr idx_val_tuples = allocate_VectorDouble( 2*size, "nearest_neighbours" );
 
     // Compute distance-based sorted list of neighbours for each data element    
     for( int i=0; i<_ndata; i++ ){
@@ -407,7 +581,8 @@ void ClusteringProblem::compute_nearest_neighbours(){
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Pre-computation of the minimum spanning tree (MST)
-// Prim's algorithm is empoyed
+// Prim's algorithm is empoyed (based on the neighbour lists if complete, or on 
+// the distance from each unselected node to the tree otherwise)
 void ClusteringProblem::compute_mst(){
 
     #ifdef DISPLAY_PROGRESS_MESSAGES
@@ -415,18 +590,10 @@ void ClusteringProblem::compute_mst(){
     #endif
 
     // Memory allocation of structures to store results
-    _mst = allocate_VectorInt( _ndata ); 
-    _priority_edges = allocate_VectorDouble( 2*(_ndata) );
-    _num_priority_edges = 0; 
-    _relevant_edges = allocate_VectorInt( _ndata );
-    _fixed_edges = allocate_VectorInt( _ndata );
-    _num_relevant_edges = 0;
-    _num_fixed_edges = 0;
-    _is_fixed = (bool *)(new bool [ _ndata ]);
-    _relevant_index = allocate_VectorInt( _ndata );
+    allocate_mst();
 
     // Mark all nodes (items) as "unselected"
-    VectorIntPtr node = allocate_VectorInt( _ndata );
+    VectorIntPtr node = allocate_VectorInt( _ndata, "mst" );
     int total_nodes = 0;
     bool *selected = (bool *)(new bool [ _ndata ]);
     for( int i=0; i<_ndata; i++ ){
@@ -440,6 +607,22 @@ void ClusteringProblem::compute_mst(){
     node[ total_nodes++ ] = r;
     selected[ r ] = true;
 
+    // Without complete neighbour lists: closest selected node to each unselected node
+    VectorFloatPtr link_distance = nullptr;
+    VectorIntPtr link = nullptr;
+    if( !_plan.full_neighbours ){
+
+        link_distance = allocate_VectorFloat( _ndata, "mst" );
+        link = allocate_VectorInt( _ndata, "mst" );
+        for( int i=0; i<_ndata; i++ ){
+
+            link_distance[ i ] = distance( r, i );
+            link[ i ] = r;
+
+        }
+
+    }
+
     // Apply Prim's method to compute the MST
     while( total_nodes < _ndata ){
 
@@ -447,29 +630,52 @@ void ClusteringProblem::compute_mst(){
         // connects a "selected" node n1 to an "unselected" node n2
         int n1, n2;
         double min_dist = INF;
-        for( int i = 0, k = 0; i < total_nodes; i++ ){
+        if( link == nullptr ){
 
-            // Consider the closest "unselected" neighbour of i-th node
-            for( k = 0; selected[ neighbour( node[ i ], k ) ] != false; k++ );
+            for( int i = 0, k = 0; i < total_nodes; i++ ){
 
-            // Update min. distance edge
-            if( distance( node[ i ], neighbour( node[ i ], k ) ) < min_dist ){
+                // Consider the closest "unselected" neighbour of i-th node
+                for( k = 0; selected[ neighbour( node[ i ], k ) ] != false; k++ );
 
-                n1 = node[ i ];
-                n2 = neighbour( n1, k );
-                min_dist = distance( n1, n2 );
+                // Update min. distance edge
+                if( distance( node[ i ], neighbour( node[ i ], k ) ) < min_dist ){
+
+                    n1 = node[ i ];
+                    n2 = neighbour( n1, k );
+                    min_dist = distance( n1, n2 );
+
+                }
 
             }
 
-        }
+        }else{
 
-        // Save new edge found (n1, n2)
-        _mst[ n2 ] = n1;
-        if( total_nodes == 1 ){
-            _mst[ n1 ] = n2;
+            for( int i = 0; i < _ndata; i++ ){
+
+                if( !selected[ i ] && link_distance[ i ] < min_dist ){
 
-            _fixed_edges[ _num_fixed_edges++ ] = n1; 
-            _is_fixed[ n1 ] = true;   
+                    n1 = link[ i ];
+                    n2 = i;
+                    min_dist = link_distance[ i ];
+
+                }
+
+            }
+
+            // Update the closest selected node of the remaining unselected nodes
+            for( int i = 0; i < _ndata; i++ ){
+
+                if( selected[ i ] || i == n2 ) continue;
+
+                float dist = distance( n2, i );
+                if( dist < link_distance[ i ] ){
+
+                    link_distance[ i ] = dist;
+                    link[ i ] = n2;
+
+                }
+
+            }
 
         }
 
@@ -477,36 +683,204 @@ void ClusteringProblem::compute_mst(){
         node[ total_nodes++ ] = n2;
         selected[ n2 ] = true;     
 
-        /////////////////////////////////
-        // Compute list priority
-        /////////////////////////////////
+        // Save new edge found (n1, n2)
+        link_mst( n1, n2, total_nodes );
+
+    }   
+
+    // Sort edges in descending order of priority
+    qsort( (void *)_priority_edges, _num_priority_edges, (2*sizeof(double)), compare_descending_tuple );
+
+    // Free memory
+    delete[] selected;
+    deallocate_VectorInt( node );
+    deallocate_VectorFloat( link_distance );
+    deallocate_VectorInt( link );
+    
+}
+////////////////////////////////////////////////////////////////////////////////
+// Memory allocation of the MST and the structures derived from it
+void ClusteringProblem::allocate_mst(){
+
+    _mst = allocate_VectorInt( _ndata, "mst" ); 
+    _priority_edges = allocate_VectorDouble( 2*(_ndata), "mst" );
+    _num_priority_edges = 0; 
+    _relevant_edges = allocate_VectorInt( _ndata, "mst" );
+    _fixed_edges = allocate_VectorInt( _ndata, "mst" );
+    _num_relevant_edges = 0;
+    _num_fixed_edges = 0;
+    _is_fixed = (bool *)(new bool [ _ndata ]);
+    _relevant_index = allocate_VectorInt( _ndata, "mst" );
+
+    // Without complete neighbour lists: ranks of the MST links
+    if( !_plan.full_neighbours ){
+
+        _mst_rank = allocate_VectorInt( _ndata, "neighbour_rank" );
+        for( int i=0; i<_ndata; i++ ) _mst_rank[ i ] = -1;
+
+    }
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Saves the MST edge (n1, n2) found by Prim's method, n1 being already selected and n2 
+// the total_nodes-th node selected, and computes its priority (interestingness)
+void ClusteringProblem::link_mst( int n1, int n2, int total_nodes ){
+
+    _mst[ n2 ] = n1;
+    if( total_nodes == 2 ){
+        _mst[ n1 ] = n2;
+
+        _fixed_edges[ _num_fixed_edges++ ] = n1; 
+        _is_fixed[ n1 ] = true;   
+
+    }
 
-        // Get ranks in NN list
-        int mock_l = neighbour_rank( n1, n2 );
-        int mock_k = neighbour_rank( n2, n1 );
+    /////////////////////////////////
+    // Compute list priority
+    /////////////////////////////////
 
-        // Priority is defined in terms of interestingness + distance/length/weigth
-        _priority_edges[ _num_priority_edges * 2        ] = n2;
+    // Get ranks in NN list
+    int mock_l = neighbour_rank( n1, n2 );
+    int mock_k = neighbour_rank( n2, n1 );
+
+    // Keep ranks of the MST links (lookups of mutation operators)
+    if( _mst_rank != nullptr ){
+
+        _mst_rank[ n2 ] = mock_k;
+        if( total_nodes == 2 ) _mst_rank[ n1 ] = mock_l;
+
+    }
+
+    // Priority is defined in terms of interestingness + distance/length/weigth
+    _priority_edges[ _num_priority_edges * 2        ] = n2;
+    _priority_edges[ _num_priority_edges * 2 + 1    ] = min( mock_l, mock_k ) + distance( n1, n2 );
+    _num_priority_edges++;
+
+    if( total_nodes == 2 ){
+
+        _priority_edges[ _num_priority_edges * 2        ] = n1;
         _priority_edges[ _num_priority_edges * 2 + 1    ] = min( mock_l, mock_k ) + distance( n1, n2 );
         _num_priority_edges++;
 
-        if( total_nodes == 2 ){
+    }
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Orients the MST of the shared instance from a random root: the nodes are selected in the 
+// order of Prim's method (the closest unselected node to the selected ones is always linked 
+// by an MST edge), so the result equals compute_mst with the same random numbers generator 
+// (unless there are ties in distance), in O(N log N)
+void ClusteringProblem::orient_mst(){
+
+    #ifdef DISPLAY_PROGRESS_MESSAGES
+        cout << "\t\tOrienting shared MST" << endl;
+    #endif
+
+    // Memory allocation of structures to store results
+    allocate_mst();
+
+    // Adjacency lists of the (undirected) shared MST
+    // Edges are (i, mst[i]); the root and its first link point to each other
+    VectorIntPtr shared = _shared->_mst;
+    VectorIntPtr first = allocate_VectorInt( size_t( _ndata ) + 1, "mst" );
+    VectorIntPtr adjacent = allocate_VectorInt( 2 * size_t( _ndata ), "mst" );
+    for( int i=0; i<=_ndata; i++ ) first[ i ] = 0;
+
+    auto edge = [ shared ]( int i ){ return !( shared[ shared[ i ] ] == i && shared[ i ] < i ); };
+
+    for( int i=0; i<_ndata; i++ ){
+
+        if( !edge( i ) ) continue;
+        first[ i + 1 ]++;
+        first[ shared[ i ] + 1 ]++;
+
+    }
+    for( int i=0; i<_ndata; i++ ) first[ i + 1 ] += first[ i ];
+
+    VectorIntPtr fill = allocate_VectorInt( _ndata, "mst" );
+    for( int i=0; i<_ndata; i++ ) fill[ i ] = first[ i ];
+    for( int i=0; i<_ndata; i++ ){
+
+        if( !edge( i ) ) continue;
+        adjacent[ fill[ i ]++ ] = shared[ i ];
+        adjacent[ fill[ shared[ i ] ]++ ] = i;
+
+    }
+    deallocate_VectorInt( fill );
 
-            _priority_edges[ _num_priority_edges * 2        ] = n1;
-            _priority_edges[ _num_priority_edges * 2 + 1    ] = min( mock_l, mock_k ) + distance( n1, n2 );
-            _num_priority_edges++;
+    // Include initial node (same random choice as compute_mst)
+    bool *selected = (bool *)(new bool [ _ndata ]);
+    for( int i=0; i<_ndata; i++ ) selected[ i ] = false;
+
+    int r = random_int( 0, _ndata-1 );
+    selected[ r ] = true;
+    int total_nodes = 1;
+
+    // Candidate links (distance, order, n1, n2), closest first (earliest on ties)
+    typedef std::tuple< float, int, int, int > Link;
+    std::priority_queue< Link, vector< Link >, std::greater< Link > > links;
+    int order = 0;
+
+    auto expand = [ & ]( int n1 ){
+
+        for( int a = first[ n1 ]; a < first[ n1 + 1 ]; a++ ){
+
+            if( !selected[ adjacent[ a ] ] ) links.push( Link( distance( n1, adjacent[ a ] ), order++, n1, adjacent[ a ] ) );
 
         }
 
-    }   
+    };
+    expand( r );
+
+    while( total_nodes < _ndata ){
+
+        int n1 = std::get< 2 >( links.top() ), n2 = std::get< 3 >( links.top() );
+        links.pop();
+
+        selected[ n2 ] = true;
+        total_nodes++;
+
+        link_mst( n1, n2, total_nodes );
+        expand( n2 );
+
+    }
 
     // Sort edges in descending order of priority
     qsort( (void *)_priority_edges, _num_priority_edges, (2*sizeof(double)), compare_descending_tuple );
 
     // Free memory
     delete[] selected;
-    deallocate_VectorInt( node );
-    
+    deallocate_VectorInt( first );
+    deallocate_VectorInt( adjacent );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Rank of j in the neighbour list of i, when only the L nearest neighbours are stored
+// Stored neighbours and MST links are looked up; otherwise, the elements closer to i 
+// than j are counted, O(N) (ties broken by index, as in the stored lists)
+int ClusteringProblem::compact_neighbour_rank( const int i, const int j ){
+
+    for( int k=0; k<_num_neighbours; k++ ){
+
+        if( _nearest_neighbours[ i ][ k ] == j ) return k;
+
+    }
+
+    if( _mst_rank != nullptr && _mst_rank[ i ] >= 0 && _mst[ i ] == j ) return _mst_rank[ i ];
+
+    float dist = distance( i, j );
+    int rank = 1;
+    for( int k=0; k<_ndata; k++ ){
+
+        if( k == i || k == j ) continue;
+
+        float other = distance( i, k );
+        if( other < dist || ( other == dist && k < j ) ) rank++;
+
+    }
+
+    return rank;
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Defines which MST edges are to be considered relevant
@@ -514,6 +888,11 @@ void ClusteringProblem::determine_relevant_edges(){
 
     int i, edge, n;
 
+    // Relevant edges are only determined once (several Nsga2 instances may request them)
+    if( _num_relevant_edges > 0 ) return;
+
+    PROFILE_PHASE( "relevant_edges" );
+
     // _delta is in range [0,100]
     // _delta = 80, means 80% of the encoding will be fixed and pre-computed
     // Thus, the 20% top MST edges are to be considered as relevant
@@ -540,5 +919,37 @@ void ClusteringProblem::determine_relevant_edges(){
 
 }
 ////////////////////////////////////////////////////////////////////////////////
+// Returns the cluster assignment and partial measures pre-computed from the fixed MST edges
+// Computed once (on first request, after relevant edges were determined) and shared by all
+// EvaluatorDelta objects, which only read from it
+ClusterAssignmentPtr ClusteringProblem::precomputed_assignment(){
+
+    std::lock_guard< std::mutex > lock( _precomputed_mutex );
 
+    if( _precomputed_assignment == nullptr ){
 
+        _precomputed_assignment = ClusterAssignmentDelta::precomputations();
+
+    }
+
+    return _precomputed_assignment;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Fingerprint of the problem instance and encoding (FNV-1a hash of the MST and relevant edges)
+// Used to verify that separate processes or runs (e.g. island processes, resumed checkpoints) 
+// work on the same instance, which depends on the data, the seed and delta
+uint64_t ClusteringProblem::signature( int encoding_length ){
+
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [ &hash ]( int value ){ hash = ( hash ^ uint64_t( uint32_t( value ) ) ) * 1099511628211ULL; };
+
+    mix( _ndata );
+    mix( encoding_length );
+    for( int i = 0; i < _ndata; i++ ) mix( _mst[ i ] );
+    for( int r = 0; r < _num_relevant_edges; r++ ) mix( _relevant_edges[ r ] );
+
+    return hash;
+
+}
+////////////////////////////////////////////////////////////////////////////////
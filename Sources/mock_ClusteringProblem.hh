@@ -30,7 +30,9 @@ Last updated: 10 July 2017
 Dependencies
 ******************/
 #include "mock_ClusteringProblem.fwd.hh"
+#include "mock_EvaluatorDelta.fwd.hh"
 #include "mock_Global.hh"
+#include "mock_Memory.hh"
 
 /******************
 Class definition
@@ -65,12 +67,21 @@ class ClusteringProblem{
 		// Pre-computed information
 		// ----------------------
 
+		Memory::Plan _plan;					// Storage strategy of the pre-computed structures (see Memory::plan)
+
 		MatrixFloatPtr _distance_matrix;	// Pre-computed distance matrix (pairwise distances between data elements)
+
+		float _min_distance;				// Minimum and maximum pairwise distances (normalisation of distances)
+		float _max_distance;
 		
 		MatrixIntPtr _nearest_neighbours;	// Pre-computed nearest neighbour matrix
 
+		int _num_neighbours;				// Length of the nearest neighbour lists (N, or L+1 if not full)
+
 		MatrixIntPtr _neighbour_rank;		// Pre-computed neighbour rank (position in nearest neighbour list) matrix
 
+		VectorIntPtr _mst_rank;				// Neighbour rank of the MST link of each element (if not full lists)
+
 		VectorDoublePtr _priority_edges;	// Sorted list of tuples (idx, interesingness) of interesting edges
 
 		int _num_priority_edges;			// Total number of interesting edges found
@@ -85,6 +96,19 @@ class ClusteringProblem{
 		bool *_is_fixed;					// For improved mutation
 		VectorIntPtr _relevant_index;
 
+		ClusterAssignmentPtr _precomputed_assignment;	// Clusters induced by the fixed edges (shared by EvaluatorDelta objects)
+		std::mutex _precomputed_mutex;					// Guards lazy construction of _precomputed_assignment
+
+		uint64_t _instance;					// Identifier of this instance (unique within the process)
+
+		ClusteringProblemPtr _shared;		// Instance whose data and pre-computations are shared (if any)
+
+	/******************
+	Friends
+	******************/
+
+	friend class Benchmark;					// Kernel benchmarks (mock_bench.cc) re-run the pre-computations
+
 	/******************
 	Methods
 	******************/
@@ -92,8 +116,10 @@ class ClusteringProblem{
 	private:
 
 		// Set-up
+		ClusteringProblem( bool precompute, ClusteringProblemPtr shared );
 		void initialise();
 		void configure();
+		void share();
 
 		// Data loading
 		void load_data();
@@ -102,19 +128,30 @@ class ClusteringProblem{
 		void compute_distance_matrix();
 		void compute_nearest_neighbours();
 		void compute_mst();
+		void orient_mst();
+		void allocate_mst();
+		void link_mst( int n1, int n2, int total_nodes );
+
+		// Neighbour rank beyond the stored (L nearest) neighbours
+		int compact_neighbour_rank( const int i, const int j );
 
 	public:
 
 		// Constructor / destructor
-		ClusteringProblem();
+		ClusteringProblem( bool precompute = true );
+		ClusteringProblem( ClusteringProblemPtr shared );
 		~ClusteringProblem();
 
+		// Pre-computations (distance matrix, nearest neighbours, MST), if deferred
+		void precompute();
+
 		// Basic accesors
 		int ndata();
 		int mdim();
 		bool labels_provided();
 		int num_real_clusters();
 		int label( int i );
+		const Memory::Plan & plan(){ return _plan; }
 
 		// Accesor to distance matrix
 		float distance( const int i, const int j );
@@ -145,6 +182,15 @@ class ClusteringProblem{
 
 		int relevant_index( int i );
 
+		// Pre-computed cluster assignment for the delta evaluation
+		ClusterAssignmentPtr precomputed_assignment();
+
+		// Identifier of this instance (cache key; addresses of deleted instances may be reused)
+		uint64_t instance(){ return _instance; }
+
+		// Fingerprint of the problem instance and encoding (MST and relevant edges)
+		uint64_t signature( int encoding_length );
+
 };
 
 /******************
@@ -188,9 +234,12 @@ inline int ClusteringProblem::label( int i ){
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Read-only access to distance/dissimilarity matrix
+// (computed and normalised on demand if the matrix is not stored)
 inline float ClusteringProblem::distance( const int i, const int j ){        
 
-    return ( i >= j ) ? _distance_matrix[ i ][ j ] : _distance_matrix[ j ][ i ]; 
+    if( _distance_matrix != nullptr ) return ( i >= j ) ? _distance_matrix[ i ][ j ] : _distance_matrix[ j ][ i ]; 
+
+    return ( i == j ) ? 0.0 : ( (*distance_measure)( _data[ i ], _data[ j ], _mdim ) - _min_distance ) / ( _max_distance - _min_distance );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -211,7 +260,9 @@ inline int ClusteringProblem::neighbour( const int i, const int j ){
 // Direct access to neighbour rank matrix
 inline int ClusteringProblem::neighbour_rank( const int i, const int j ){ 
 
-	return _neighbour_rank[ i ][ j ]; 
+	if( _neighbour_rank != nullptr ) return _neighbour_rank[ i ][ j ]; 
+
+	return compact_neighbour_rank( i, j );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,88 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Context.hh"
+#include "mock_Global.hh"
+
+Context Context::_default;
+
+thread_local RandomPtr rnd;						// Random numbers generator (one per thread)
+const int num_objectives = 2;					// Number of optimisation objectives to use	
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+Context::Context() : 
+
+	problem( nullptr ),
+	algorithm( nullptr ),
+	random( nullptr ),
+	seed( 0 ),
+	L( 10 ),
+	Kmax( -1 ),
+	initial_solutions( -1 ),
+	recoverable( false )
+
+{}
+////////////////////////////////////////////////////////////////////////////////
+// Sets a parameter (option names and values are case-insensitive, except for filenames and addresses)
+void Context::set( string option, string value ){
+
+	std::transform( option.begin(), option.end(), option.begin(), ::tolower );
+	if( (option != "--output") && (option != "--file") && (option != "--listen") && (option != "--connect") && (option != "--runs") && (option != "--batch") && (option != "--serve") ){
+
+		std::transform( value.begin(), value.end(), value.begin(), ::tolower );
+
+	}
+
+	if( option == "--seed" ) seed = stoul( value );
+	else if( option == "--lparameter" ) L = stoi( value );
+	else if( option == "--kmax" ) Kmax = stoi( value );
+	else if( option == "--initialsize" ) initial_solutions = stoi( value );
+	else parameters.push_back( { option, value } );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Binds the given context (and its generator) to the calling thread
+Context::Scope::Scope( ContextPtr context, bool random ) : 
+
+	_previous( Binding< Context >::current ),
+	_previous_rnd( rnd ),
+	_random( random )
+
+{
+
+	Binding< Context >::current = context;
+	if( _random ) rnd = context->random;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Restores the previous context (and generator) of the calling thread
+Context::Scope::~Scope(){
+
+	Binding< Context >::current = _previous;
+	if( _random ) rnd = _previous_rnd;
+
+}
+////////////////////////////////////////////////////////////////////////////////
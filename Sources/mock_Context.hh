@@ -0,0 +1,135 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_CONTEXT_HH__
+#define __MOCK_CONTEXT_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Context.fwd.hh"
+#include "mock_ClusteringProblem.fwd.hh"
+#include "mock_Algorithm.fwd.hh"
+#include "mock_Random.fwd.hh"
+#include "mock_Profiler.hh"
+#include <string>
+#include <vector>
+
+/******************
+Class definition
+******************/
+
+// Settings and state of a clustering job: parameters, problem instance, search algorithm, 
+// main random numbers generator and run instrumentation
+// Code reaches the context of the calling thread through the globals of mock_Global.hh 
+// (PROBLEM, input_parameters, mock_L...). Threads bind a context with Context::Scope, so that
+// several jobs can run in one process, each on its own threads (see Job); threads started by a 
+// job (worker pools, islands, writers) bind the context of the thread starting them
+// Threads that bind no context use the default one of the process (command-line program)
+// NOTE: a context does not own the problem, algorithm and generator it refers to
+class Context{
+
+	/******************
+	Attributes
+	******************/
+
+	public:
+
+		std::vector< std::vector< std::string > > parameters;	// List of (option, value) parameters
+
+		ClusteringProblemPtr problem;			// Problem instance
+
+		AlgorithmPtr algorithm;					// Search algorithm
+
+		RandomPtr random;						// Main random numbers generator
+
+		unsigned long int seed;					// Seed for the random numbers generator (0: time)
+
+		int L;									// Number of nearest neighbours to use in mutation and connectivity computation
+
+		int Kmax;								// Upper bound on the number of clusters k generated by k-means during initialisation
+
+		int initial_solutions;					// Size of the initial set of solutions
+
+		Profiler profiler;						// Phase timers and counters (run report)
+
+		bool recoverable;						// Errors throw std::runtime_error instead of ending the process?
+
+	private:
+
+		static Context _default;				// Context of threads which bind none
+
+		// Context bound to the calling thread (Binding< Context >::current)
+		// NOTE: a template, so that its (constant) initialisation is visible to every translation 
+		// unit; otherwise each access calls the TLS initialisation wrapper, which prevents hoisting 
+		// PROBLEM, mock_L... out of the loops of the evaluation kernels
+		template < typename T > struct Binding{ static thread_local T * current; };
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor (default settings)
+		Context();
+
+		// Sets a parameter: context settings (--seed, --lparameter, --kmax, --initialsize)
+		// are kept apart, other options are added to the list of parameters
+		void set( std::string option, std::string value );
+
+		// Context of the calling thread
+		static ContextPtr current(){ return Binding< Context >::current; }
+
+		// Binds a context to the calling thread for the lifetime of the object (and its main 
+		// random numbers generator, unless the thread uses generators of its own, e.g. workers)
+		class Scope{
+
+			private:
+
+				ContextPtr _previous;
+				RandomPtr _previous_rnd;
+				bool _random;
+
+			public:
+
+				Scope( ContextPtr context, bool random = true );
+				~Scope();
+
+		};
+
+};
+
+template < typename T > thread_local T * Context::Binding< T >::current = &Context::_default;
+
+////////////////////////////////////////////////////////////////////////////////
+// Instrumentation of the job of the calling thread
+inline Profiler & Profiler::current(){
+
+	return Context::current()->profiler;
+
+}
+
+#endif
@@ -59,6 +59,7 @@ class Evaluator{
 
 		// Accesors
 		virtual unsigned long int total_evaluations() const = 0;
+		void set_total_evaluations( unsigned long int n ){ _total_evaluations = n; }	// e.g. when resuming a search
 
 		// Evaluators' mandatory methods
 		virtual void evaluate( SolutionPtr solution ) = 0;
@@ -27,16 +27,19 @@ Last updated: 10 July 2017
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
-EvaluatorDelta::EvaluatorDelta() :
+// If batch_split == true, populations are assumed to be split-encoded (binary)
+// and are evaluated in bit-sliced batches (see ClusterAssignmentBatch)
+EvaluatorDelta::EvaluatorDelta( bool batch_split ) :
 
     Evaluator()
 
 {   
 
     // Allocate memory
-    _clusters = new ClusterAssignmentDelta();
+    _clusters = new ClusterAssignmentDelta( PROBLEM->precomputed_assignment() );
     _processed = new bool [ PROBLEM->ndata() ];
-    _full_encoding = allocate_VectorInt( PROBLEM->ndata() );    
+    _full_encoding = allocate_VectorInt( PROBLEM->ndata(), "delta_evaluator" );    
+    _batch = ( batch_split ) ? new ClusterAssignmentBatch( _clusters->precomputed() ) : nullptr;
 
     // Initialise aux. structures
     for( int f=0; f<PROBLEM->num_fixed_edges(); f++ ){
@@ -51,6 +54,7 @@ EvaluatorDelta::EvaluatorDelta() :
 EvaluatorDelta::~EvaluatorDelta(){
 
     // Deallocate memory
+    delete _batch;
     delete _clusters;    
     delete[] _processed;
     deallocate_VectorInt( _full_encoding );
@@ -105,11 +109,38 @@ void EvaluatorDelta::evaluate( SolutionPtr solution ){
     solution->kclusters() = _clusters->total_clusters(); 
     solution->evaluation() = _total_evaluations;
 
+    PROFILE_COUNT( EVALUATIONS, 1 );
+    PROFILE_COUNT( DELTA_EVALUATIONS, 1 );
+    PROFILE_COUNT( DELTA_MERGES, _clusters->initial_clusters() - _clusters->total_clusters() );
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Evaluates the given population of solutions
 void EvaluatorDelta::evaluate( PopulationPtr population ){
 
+    // Split-encoded populations: evaluate LANES solutions at once
+    if( _batch != nullptr ){
+
+        for( int i=0, count; i<population->size(); i+=count ){
+
+            count = min( ClusterAssignmentBatch::LANES, population->size() - i );
+            _batch->evaluate( population, i, count, _total_evaluations );
+            _total_evaluations += count;
+
+            #if PROFILE_LEVEL > 0
+                long merges = 0;
+                for( int s=i; s<i+count; s++ ) merges += _clusters->initial_clusters() - (*population)[ s ]->kclusters();
+                PROFILE_COUNT( EVALUATIONS, count );
+                PROFILE_COUNT( DELTA_EVALUATIONS, count );
+                PROFILE_COUNT( DELTA_MERGES, merges );
+            #endif
+
+        }
+
+        return;
+
+    }
+
     // Evaluate each individual in the given population
     for( int i=0; i<population->size(); i++ ) evaluate( (*population)[ i ] );
 
@@ -35,4 +35,7 @@ typedef ClusterAssignment * ClusterAssignmentPtr;
 class ClusterAssignmentDelta;
 typedef ClusterAssignmentDelta * ClusterAssignmentDeltaPtr;
 
+class ClusterAssignmentBatch;
+typedef ClusterAssignmentBatch * ClusterAssignmentBatchPtr;
+
 #endif 
@@ -32,6 +32,7 @@ Dependencies
 #include "mock_EvaluatorDelta.fwd.hh"
 #include "mock_Evaluator.hh"
 #include <queue>
+#include <unordered_map>
 
 /******************
 Class definition
@@ -54,6 +55,8 @@ class EvaluatorDelta : public Evaluator {
 		VectorIntPtr _full_encoding;
 		bool * _processed;
 
+		ClusterAssignmentBatchPtr _batch;		// Bit-sliced evaluation of split-encoded populations (optional)
+
 	/******************
 	Methods
 	******************/
@@ -61,7 +64,7 @@ class EvaluatorDelta : public Evaluator {
 	public:
 
 		// Constructor / destructor
-		EvaluatorDelta();
+		EvaluatorDelta( bool batch_split = false );
 		~EvaluatorDelta();
 
 		// Accesor to evaluations counter
@@ -82,6 +85,7 @@ Class definition
 class ClusterAssignment{
 
 	friend class ClusterAssignmentDelta;
+	friend class ClusterAssignmentBatch;
 
 	/******************
 	Attributes
@@ -92,7 +96,10 @@ class ClusterAssignment{
 		// Used for cluster assignment
 		VectorIntPtr _assignment; 				// Cluster assignmnt of each data point
 		int _total_clusters; 		  			// Total number of clusters - 1
-		MatrixIntPtr _clusters;					// Matrix of clusters
+		VectorIntPtr _size;						// Size of each cluster
+		VectorIntPtr _first;					// Members of each cluster (linked lists): first and last element...
+		VectorIntPtr _last;
+		VectorIntPtr _next;						// ... and next element of each data point (-1: last)
     	std::queue<int> _removed;				// Auxiliar structure to store removed clusters (merge operation)
 
     	// Used for the Variance measure    	
@@ -103,8 +110,8 @@ class ClusterAssignment{
     	double _connectivity;
     	VectorDoublePtr _cnn_penalty;			// Pre-computed penalties for the connectivity measure
 		const int _knn;							// Number of nearest neighbours to use
-		MatrixDoublePtr _cnn_contribution;		// Contribution of each pair of cluster to Connectivity measure
-		MatrixIntPtr _cnn_pair;					// List of unique cluster pairs contributing to Connectivity
+		VectorDoublePtr _cnn_contribution;		// Contribution of each pair of clusters to Connectivity measure
+		VectorIntPtr _cnn_pair;					// List of unique cluster pairs contributing to Connectivity (2 per pair)
 		unsigned long int _cnn_pairs;			// Number of unique cluster pairs contributing to Connectivity
 
 	/******************
@@ -114,13 +121,16 @@ class ClusterAssignment{
 	public:
 
 		// Constructor
-		ClusterAssignment() : _total_clusters( -1 ), _knn( mock_L ) {
+		ClusterAssignment() : _total_clusters( -1 ), _cnn_penalty( nullptr ), _knn( mock_L ), _cnn_contribution( nullptr ), _cnn_pair( nullptr ), _cnn_pairs( 0 ) {
 
     		// Memory allocation
-			_assignment = allocate_VectorInt( PROBLEM->ndata() );
-		    _clusters = allocate_MatrixInt( PROBLEM->ndata(), PROBLEM->ndata()+1 );
-		    _variance = allocate_VectorDouble( PROBLEM->ndata() );
-		    _centre = allocate_MatrixFloat( PROBLEM->ndata(), PROBLEM->mdim() );
+			_assignment = allocate_VectorInt( PROBLEM->ndata(), "cluster_assignment" );
+		    _size = allocate_VectorInt( PROBLEM->ndata(), "cluster_assignment" );
+		    _first = allocate_VectorInt( PROBLEM->ndata(), "cluster_assignment" );
+		    _last = allocate_VectorInt( PROBLEM->ndata(), "cluster_assignment" );
+		    _next = allocate_VectorInt( PROBLEM->ndata(), "cluster_assignment" );
+		    _variance = allocate_VectorDouble( PROBLEM->ndata(), "cluster_assignment" );
+		    _centre = allocate_MatrixFloat( PROBLEM->ndata(), PROBLEM->mdim(), "cluster_assignment" );
 
 			// Initialise
 			for( int i=0; i<PROBLEM->ndata(); i++ )	_assignment[ i ] = -1; 
@@ -132,12 +142,15 @@ class ClusterAssignment{
 
     		// Deallocate memory
 			deallocate_VectorInt( _assignment );
-		    deallocate_MatrixInt( _clusters, PROBLEM->ndata() );
+		    deallocate_VectorInt( _size );
+		    deallocate_VectorInt( _first );
+		    deallocate_VectorInt( _last );
+		    deallocate_VectorInt( _next );
 		    deallocate_VectorDouble( _variance );
 		    deallocate_MatrixFloat( _centre, PROBLEM->ndata() );
 		    deallocate_VectorDouble( _cnn_penalty );
-		    deallocate_MatrixDouble( _cnn_contribution, _total_clusters+1 );
-		    deallocate_MatrixInt( _cnn_pair, _cnn_pairs );
+		    deallocate_VectorDouble( _cnn_contribution );
+		    deallocate_VectorInt( _cnn_pair );
 
 		}
 
@@ -166,8 +179,9 @@ class ClusterAssignment{
             }
 
             // Insert given element
-            _clusters[ c ][ 0 ] = 1;
-            _clusters[ c ][ 1 ] = element;
+            _size[ c ] = 1;
+            _first[ c ] = _last[ c ] = element;
+            _next[ element ] = -1;
             _assignment[ element ] = c;
 
             // Return cluster id (index)
@@ -178,7 +192,10 @@ class ClusterAssignment{
 		// Insert given element into cluster
 		void insert( int cluster, int element ){
 
-			_clusters[ cluster ][ ++_clusters[ cluster ][ 0 ] ] = element;
+			_next[ _last[ cluster ] ] = element;
+			_next[ element ] = -1;
+			_last[ cluster ] = element;
+			_size[ cluster ]++;
 			_assignment[ element ] = cluster;
 
 		}		
@@ -187,13 +204,12 @@ class ClusterAssignment{
 		void merge( int c1, int c2 ){			 
 
 			// Empty c2 and move all elements to c1
-			for( int j=1; j<=_clusters[ c2 ][ 0 ]; j++ ){
-
-				_clusters[ c1 ][ ++_clusters[ c1 ][ 0 ] ] = _clusters[ c2 ][ j ];
-				_assignment[ _clusters[ c2 ][ j ] ] = c1;
+			for( int j=_first[ c2 ]; j!=-1; j=_next[ j ] ) _assignment[ j ] = c1;
 
-			}
-			_clusters[ c2 ][ 0 ] = 0;
+			_next[ _last[ c1 ] ] = _first[ c2 ];
+			_last[ c1 ] = _last[ c2 ];
+			_size[ c1 ] += _size[ c2 ];
+			_size[ c2 ] = 0;
 			_removed.push( c2 );
 
 		}		
@@ -207,8 +223,8 @@ class ClusterAssignment{
 				sum_VectorFloat( _centre[ _assignment[ i ] ], (*PROBLEM)[ i ], _centre[ _assignment[ i ] ], PROBLEM->mdim() );
 
 			for( int i=0; i<=_total_clusters; i++)
-		    	if( _clusters[ i ][ 0 ] > 1 )
-		    		divide_VectorFloat_by( _centre[ i ], float(_clusters[ i ][ 0 ]), _centre[ i ], PROBLEM->mdim() );
+		    	if( _size[ i ] > 1 )
+		    		divide_VectorFloat_by( _centre[ i ], float(_size[ i ]), _centre[ i ], PROBLEM->mdim() );
 
 		    // Compute variances
 		    for( int i = 0; i < PROBLEM->ndata(); i++ ){
@@ -225,17 +241,25 @@ class ClusterAssignment{
 
 			// Pre-compute penalty values used by the connectivity measure
 		    // Penalty values are defined according to positions in NN list
-		    _cnn_penalty = allocate_VectorDouble( _knn );
+		    _cnn_penalty = allocate_VectorDouble( _knn, "cluster_assignment" );
 		    for( int j=0; j<_knn; j++ ) _cnn_penalty[ j ] = 1.0/(double(j)+1.0);
 
 		    // Prepare structures for computing pairwise connectivity contributions
+		    // Pairs are identified through a matrix of pair indices, or a hash table (see Memory::plan)
+		    // NOTE: at most one new pair per (element, neighbour), and one per pair of clusters
+		    const long long clusters = _total_clusters + 1;
+		    const size_t bound = size_t( std::min( (long long)( PROBLEM->ndata() ) * _knn, clusters * ( clusters - 1 ) / 2 ) );
 			_cnn_pairs = 0;	
-			_cnn_pair = MatrixIntPtr( new VectorIntPtr [ int((_total_clusters+1.0)*(_total_clusters)/2.0) ] );				
-			_cnn_contribution = allocate_MatrixDouble( _total_clusters+1, _total_clusters+1 );	
-			for( int i=0; i<=_total_clusters; i++){
-				for( int j=0; j<=_total_clusters; j++){
-					_cnn_contribution[ i ][ j ] = 0.0;
-				}
+			_cnn_pair = allocate_VectorInt( 2 * bound, "cnn_pairs" );
+			_cnn_contribution = allocate_VectorDouble( bound, "cnn_contribution" );
+
+			MatrixIntPtr index = nullptr;
+			std::unordered_map< uint64_t, int > hashed;
+			if( PROBLEM->plan().dense_pairs ){
+
+				index = allocate_MatrixInt( clusters, clusters, "cnn_index" );
+				for( int i=0; i<clusters; i++ ) std::fill( index[ i ], index[ i ] + clusters, -1 );
+
 			}
 
 			// Compute connectivity measure
@@ -255,17 +279,34 @@ class ClusterAssignment{
 		            	// Update pre-computed Connectivity measure
 		                _connectivity += _cnn_penalty[ j ];
 
+		                // Index of this (unordered) pair of clusters
+		                int pair;
+		                if( index != nullptr ){
+
+		                	pair = index[ label ][ nn_label ];
+
+		                }else{
+
+		                	auto found = hashed.find( ( uint64_t( min( label, nn_label ) ) << 32 ) | uint64_t( max( label, nn_label ) ) );
+		                	pair = ( found != hashed.end() ) ? found->second : -1;
+
+		                }
+
 		                // New identified cluster pair contributing to Connectivity
-		                if( _cnn_contribution[ label ][ nn_label ] < 0.1 ){
-		                	_cnn_pair[ _cnn_pairs ] = allocate_VectorInt( 2 );
-		                	_cnn_pair[ _cnn_pairs ][ 0 ] = label;
-		                	_cnn_pair[ _cnn_pairs ][ 1 ] = nn_label;
-		                	_cnn_pairs++;
+		                if( pair < 0 ){
+
+		                	pair = _cnn_pairs++;
+		                	_cnn_pair[ 2 * pair ] = label;
+		                	_cnn_pair[ 2 * pair + 1 ] = nn_label;
+		                	_cnn_contribution[ pair ] = 0.0;
+
+		                	if( index != nullptr ) index[ label ][ nn_label ] = index[ nn_label ][ label ] = pair;
+		                	else hashed[ ( uint64_t( min( label, nn_label ) ) << 32 ) | uint64_t( max( label, nn_label ) ) ] = pair;
+
 		                }
 
 		                // Update Connectivity contributions for this particular pair of clusters
-		                _cnn_contribution[ label ][ nn_label ] += _cnn_penalty[ j ];
-		                _cnn_contribution[ nn_label ][ label ] = _cnn_contribution[ label ][ nn_label ];
+		                _cnn_contribution[ pair ] += _cnn_penalty[ j ];
 
 		            }
 		            
@@ -273,6 +314,8 @@ class ClusterAssignment{
 
 		    }  
 
+		    deallocate_MatrixInt( index, clusters );
+
 		}
 
 };
@@ -290,8 +333,10 @@ class ClusterAssignmentDelta{
 	private:
 
     	ClusterAssignmentPtr _precomputed;		// Pre-computed cluster assignment and performance measures
-    	MatrixIntPtr _cluster_members;			// List of pre-computed clusters that are members of a final cluster
 		VectorIntPtr _cluster_membership;		// Membership (parent cluster) of each pre-computed cluster
+		VectorIntPtr _member_next;				// Pre-computed clusters that are members of a final cluster (linked lists, 
+		VectorIntPtr _member_last;				// headed by the final cluster itself): next member and last member...
+		VectorIntPtr _member_count;				// ... and number of members
 		VectorIntPtr _cluster_size;				// Final cluster sizes
 		MatrixFloatPtr _centre;					// Final cluster centres
     	int _total_clusters;					// Total number of resulting clusters
@@ -303,19 +348,16 @@ class ClusterAssignmentDelta{
 	public:
 
 		// Constructor
-		ClusterAssignmentDelta() {
-
-			// Precompute cluster assignment and evaluation measures
-			precomputations();
+		// The given pre-computed cluster assignment is shared (read-only) and is not owned
+		ClusterAssignmentDelta( ClusterAssignmentPtr precomputed ) : _precomputed( precomputed ) {
     		
 			// Memory allocation
-			_cluster_members = allocate_MatrixInt( _precomputed->_total_clusters + 1, _precomputed->_total_clusters + 2 );
-			_cluster_membership = allocate_VectorInt( _precomputed->_total_clusters+1 );
-			_cluster_size = allocate_VectorInt( _precomputed->_total_clusters+1 );
-			_centre = allocate_MatrixFloat( _precomputed->_total_clusters+1, PROBLEM->mdim() );
-
-			// Initialise cluster members
-			for( int i=0; i<=_precomputed->_total_clusters; i++) _cluster_members[ i ][ 1 ] = i;
+			_cluster_membership = allocate_VectorInt( _precomputed->_total_clusters+1, "delta_evaluator" );
+			_member_next = allocate_VectorInt( _precomputed->_total_clusters+1, "delta_evaluator" );
+			_member_last = allocate_VectorInt( _precomputed->_total_clusters+1, "delta_evaluator" );
+			_member_count = allocate_VectorInt( _precomputed->_total_clusters+1, "delta_evaluator" );
+			_cluster_size = allocate_VectorInt( _precomputed->_total_clusters+1, "delta_evaluator" );
+			_centre = allocate_MatrixFloat( _precomputed->_total_clusters+1, PROBLEM->mdim(), "delta_evaluator" );
 
 		}
 
@@ -323,19 +365,20 @@ class ClusterAssignmentDelta{
 		~ClusterAssignmentDelta(){
 
 			// Deallocate memory
-			deallocate_MatrixInt( _cluster_members, _precomputed->_total_clusters + 1 );
 			deallocate_VectorInt( _cluster_membership );
+			deallocate_VectorInt( _member_next );
+			deallocate_VectorInt( _member_last );
+			deallocate_VectorInt( _member_count );
 			deallocate_VectorInt( _cluster_size ); 
 			deallocate_MatrixFloat( _centre, _precomputed->_total_clusters+1 );
-			delete _precomputed;
 
 		}
 
 		// Precomputation of cluster assignment and measures
-		// based on fixed encoding positions
-		void precomputations(){			
+		// based on fixed encoding positions (see ClusteringProblem::precomputed_assignment)
+		static ClusterAssignmentPtr precomputations(){			
 			
-		    _precomputed = new ClusterAssignment();
+		    ClusterAssignmentPtr _precomputed = new ClusterAssignment();
 
 		    for( int f=0; f<PROBLEM->num_fixed_edges(); f++ ){
 
@@ -398,6 +441,8 @@ class ClusterAssignmentDelta{
 		    _precomputed->precompute_variance();
 		    _precomputed->precompute_connectivity();
 
+		    return _precomputed;
+
 		}
 
 		// Restore data structures 
@@ -406,8 +451,10 @@ class ClusterAssignmentDelta{
 			
 			for( int i=0; i<=_precomputed->_total_clusters; i++ ){
 
-				_cluster_members[ i ][ 0 ] = 1;
 				_cluster_membership[ i ] = i;
+				_member_next[ i ] = -1;
+				_member_last[ i ] = i;
+				_member_count[ i ] = 1;
 				_cluster_size[ i ] = 0;
 				for( int d=0; d<PROBLEM->mdim(); d++ ) _centre[ i ][ d ] = 0.0;
 
@@ -427,25 +474,14 @@ class ClusterAssignmentDelta{
 			if( c1 != c2 ){
 			
 				// Try to remove always the smallest cluster		
-				if( _cluster_members[ c1 ][ 0 ] < _cluster_members[ c2 ][ 0 ] ){
+				if( _member_count[ c1 ] < _member_count[ c2 ] ) std::swap( c1, c2 );
 
-					// Remove cluster c1, move all cluster members to c2
-					for( int i=1; i<=_cluster_members[ c1 ][ 0 ]; i++ ){
-						_cluster_members[ c2 ][ ++_cluster_members[ c2 ][ 0 ] ] = _cluster_members[ c1 ][ i ];
-						_cluster_membership[ _cluster_members[ c1 ][ i ] ] = c2;
-					}
-					_cluster_members[ c1 ][ 0 ] = 0;
-
-				}else{
-
-					// Remove cluster c2, move all cluster members to c1
-					for( int i=1; i<=_cluster_members[ c2 ][ 0 ]; i++ ){
-						_cluster_members[ c1 ][ ++_cluster_members[ c1 ][ 0 ] ] = _cluster_members[ c2 ][ i ];
-						_cluster_membership[ _cluster_members[ c2 ][ i ] ] = c1;
-					}
-					_cluster_members[ c2 ][ 0 ] = 0;
-
-				}	
+				// Remove cluster c2, move all cluster members to c1
+				for( int i=c2; i!=-1; i=_member_next[ i ] ) _cluster_membership[ i ] = c1;
+				_member_next[ _member_last[ c1 ] ] = c2;
+				_member_last[ c1 ] = _member_last[ c2 ];
+				_member_count[ c1 ] += _member_count[ c2 ];
+				_member_count[ c2 ] = 0;
 
 				// Update number of clusters
 				_total_clusters--;			
@@ -465,7 +501,7 @@ class ClusterAssignmentDelta{
 				int m = _cluster_membership[ c ];
 
 				// Update size
-				_cluster_size[ m ] += _precomputed->_clusters[ c ][ 0 ];
+				_cluster_size[ m ] += _precomputed->_size[ c ];
 
 				// Update sum of variances
 				variance += _precomputed->_variance[ c ];
@@ -473,7 +509,7 @@ class ClusterAssignmentDelta{
 				// Update centroid
 				for( int d=0; d<PROBLEM->mdim(); d++ ){ 
 
-					_centre[ m ][ d ] += ( _precomputed->_clusters[ c ][ 0 ] * _precomputed->_centre[ c ][ d ] );
+					_centre[ m ][ d ] += ( _precomputed->_size[ c ] * _precomputed->_centre[ c ][ d ] );
 
 				}
 
@@ -493,7 +529,7 @@ class ClusterAssignmentDelta{
 				int m = _cluster_membership[ c ];
 
 				double diff = PROBLEM->distance_measure( _precomputed->_centre[ c ],  _centre[ m ], PROBLEM->mdim() );
-		        variance += _precomputed->_clusters[ c ][ 0 ] * ( diff * diff );
+		        variance += _precomputed->_size[ c ] * ( diff * diff );
 
 			}
 
@@ -508,10 +544,10 @@ class ClusterAssignmentDelta{
 
 			for( int i=0; i<_precomputed->_cnn_pairs; i++ ){
 
-				int c1 = _precomputed->_cnn_pair[ i ][ 0 ], c2 = _precomputed->_cnn_pair[ i ][ 1 ];
+				int c1 = _precomputed->_cnn_pair[ 2 * i ], c2 = _precomputed->_cnn_pair[ 2 * i + 1 ];
 
 				if( _cluster_membership[ c1 ] == _cluster_membership[ c2 ] )
-					cnn -= _precomputed->_cnn_contribution[ c1 ][ c2 ]; 
+					cnn -= _precomputed->_cnn_contribution[ i ]; 
 
 			}
 
@@ -526,8 +562,343 @@ class ClusterAssignmentDelta{
 
 		}
 
+		// Number of clusters before merging (pre-computed clusters plus relevant edges)
+		int initial_clusters(){
+
+			return _precomputed->_total_clusters + 1;
+
+		}
+
+		// Read-only access to the pre-computed cluster assignment
+		ClusterAssignmentPtr precomputed(){
+
+			return _precomputed;
+
+		}
+
 };
 ////////////////////////////////////////////////////////////////////////////////
 
-#endif
+/******************
+Class definition
+******************/
+// Bit-sliced evaluation of split-encoded (binary) solutions
+// Up to LANES solutions are transposed into one bitmask per relevant edge (bit s
+// denotes whether the edge is present in the s-th solution), so that component 
+// membership and connectivity savings are computed in lockstep for all of them
+class ClusterAssignmentBatch{
+
+	/******************
+	Attributes
+	******************/
+
+	public:
+
+		static const int LANES = 64;			// Number of solutions evaluated simultaneously (bits per mask)
+
+	private:
+
+    	ClusterAssignmentPtr _precomputed;		// Pre-computed cluster assignment and performance measures (not owned)
+    	int _nclusters;							// Number of pre-computed clusters (nodes of the contracted MST)
+    	int _nedges;							// Number of relevant edges (encoding length)
+    	VectorIntPtr _edge_end;					// Pre-computed clusters joined by each relevant edge (2 per edge)
+
+    	VectorIntPtr _tree_edge;				// Relevant edges in breadth-first order of the contracted MST
+    	VectorIntPtr _tree_child;				// Cluster labelled by each tree edge (farthest from the root)
+    	VectorIntPtr _tree_parent;				// Cluster the child is joined to when the edge is present
+    	int _num_tree_edges;					// Number of tree edges
+    	VectorIntPtr _cycle_edge;				// Relevant edges closing a cycle in the contracted graph
+    	int _num_cycle_edges;					// Number of cycle edges (duplicated MST links only)
+
+    	uint64_t * _mask;						// Per-edge bitmasks (transposed genotypes of the batch)
+    	VectorIntPtr _label;					// Component label of each pre-computed cluster [cluster][lane]
+    	VectorIntPtr _size;						// Final cluster sizes [lane][cluster]
+    	VectorFloatPtr _centre;					// Final cluster centres [lane][cluster][dimension]
+    	double _base_variance;					// Sum of the variances of all pre-computed clusters
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor
+		ClusterAssignmentBatch( ClusterAssignmentPtr precomputed ) : 
+
+			_precomputed( precomputed ),
+			_nclusters( precomputed->_total_clusters + 1 ),
+			_nedges( PROBLEM->num_relevant_edges() ),
+			_num_tree_edges( 0 ),
+			_num_cycle_edges( 0 ),
+			_base_variance( 0.0 )
+
+		{
+
+			// Memory allocation
+			_edge_end = allocate_VectorInt( 2 * _nedges, "delta_evaluator" );
+			_tree_edge = allocate_VectorInt( _nedges, "delta_evaluator" );
+			_tree_child = allocate_VectorInt( _nedges, "delta_evaluator" );
+			_tree_parent = allocate_VectorInt( _nedges, "delta_evaluator" );
+			_cycle_edge = allocate_VectorInt( _nedges, "delta_evaluator" );
+			_mask = new uint64_t [ _nedges ];
+			_label = allocate_VectorInt( size_t( _nclusters ) * LANES, "delta_evaluator" );
+			_size = allocate_VectorInt( size_t( LANES ) * _nclusters, "delta_evaluator" );
+			_centre = allocate_VectorFloat( size_t( LANES ) * _nclusters * PROBLEM->mdim(), "delta_evaluator" );
+
+			// Pre-computed clusters joined by each relevant edge
+			for( int r=0; r<_nedges; r++ ){
+
+				int edge = PROBLEM->relevant_edge( r );
+				_edge_end[ 2*r   ] = _precomputed->_assignment[ edge ];
+				_edge_end[ 2*r+1 ] = _precomputed->_assignment[ PROBLEM->mst_edge( edge ) ];
+
+			}
+
+			// Sum of the variances of pre-computed clusters (same order as ClusterAssignmentDelta)
+			for( int c=0; c<_nclusters; c++ ) _base_variance += _precomputed->_variance[ c ];
+
+			// Order edges so that each cluster is labelled after the one it hangs from
+			order_edges();
+
+		}
+
+		// Destructor
+		~ClusterAssignmentBatch(){
+
+			// Deallocate memory
+			deallocate_VectorInt( _edge_end );
+			deallocate_VectorInt( _tree_edge );
+			deallocate_VectorInt( _tree_child );
+			deallocate_VectorInt( _tree_parent );
+			deallocate_VectorInt( _cycle_edge );
+			delete[] _mask;
+			deallocate_VectorInt( _label );
+			deallocate_VectorInt( _size );
+			deallocate_VectorFloat( _centre );
+
+		}
+
+		// Breadth-first traversal of the graph of pre-computed clusters (contracted MST)
+		// Tree edges are stored in visiting order; edges reaching an already visited
+		// cluster (only possible for the duplicated root link of the MST) are kept apart
+		void order_edges(){
+
+			// Adjacency lists (compressed row storage)
+			VectorIntPtr offset = allocate_VectorInt( _nclusters + 1 );
+			VectorIntPtr adjacent = allocate_VectorInt( 2 * _nedges );
+			for( int c=0; c<=_nclusters; c++ ) offset[ c ] = 0;
+			for( int r=0; r<_nedges; r++ ){
+				offset[ _edge_end[ 2*r ] + 1 ]++;
+				offset[ _edge_end[ 2*r+1 ] + 1 ]++;
+			}
+			for( int c=0; c<_nclusters; c++ ) offset[ c+1 ] += offset[ c ];
+			VectorIntPtr fill = allocate_VectorInt( _nclusters );
+			for( int c=0; c<_nclusters; c++ ) fill[ c ] = offset[ c ];
+			for( int r=0; r<_nedges; r++ ){
+				adjacent[ fill[ _edge_end[ 2*r ] ]++ ] = r;
+				adjacent[ fill[ _edge_end[ 2*r+1 ] ]++ ] = r;
+			}
+
+			// Traverse each connected component
+			bool *visited = new bool [ _nclusters ];
+			bool *used = new bool [ _nedges ];
+			VectorIntPtr queue = allocate_VectorInt( _nclusters );
+			for( int c=0; c<_nclusters; c++ ) visited[ c ] = false;
+			for( int r=0; r<_nedges; r++ ) used[ r ] = false;
+
+			for( int root=0; root<_nclusters; root++ ){
+
+				if( visited[ root ] ) continue;
+
+				int head = 0, tail = 0;
+				visited[ root ] = true;
+				queue[ tail++ ] = root;
+
+				while( head < tail ){
+
+					int v = queue[ head++ ];
+
+					for( int i=offset[ v ]; i<offset[ v+1 ]; i++ ){
+
+						int r = adjacent[ i ];
+						if( used[ r ] ) continue;
+						used[ r ] = true;
 
+						int u = ( _edge_end[ 2*r ] == v ) ? _edge_end[ 2*r+1 ] : _edge_end[ 2*r ];
+
+						if( !visited[ u ] ){
+
+							visited[ u ] = true;
+							queue[ tail++ ] = u;
+							_tree_edge[ _num_tree_edges ] = r;
+							_tree_child[ _num_tree_edges ] = u;
+							_tree_parent[ _num_tree_edges ] = v;
+							_num_tree_edges++;
+
+						}else{
+
+							_cycle_edge[ _num_cycle_edges++ ] = r;
+
+						}
+
+					}
+
+				}
+
+			}
+
+			// Free memory
+			delete[] visited;
+			delete[] used;
+			deallocate_VectorInt( queue );
+			deallocate_VectorInt( fill );
+			deallocate_VectorInt( adjacent );
+			deallocate_VectorInt( offset );
+
+		}
+
+		// Evaluate 'count' (<= LANES) consecutive solutions of the given population, starting at 'first'
+		// Evaluation numbers are assigned consecutively after the given 'evaluations' counter
+		void evaluate( PopulationPtr population, int first, int count, unsigned long int evaluations ){
+
+			int mdim = PROBLEM->mdim();
+
+			// Transpose genotypes into per-edge bitmasks
+			for( int r=0; r<_nedges; r++ ) _mask[ r ] = 0;
+			for( int s=0; s<count; s++ ){
+
+				SolutionPtr sol = (*population)[ first + s ];
+				uint64_t bit = uint64_t( 1 ) << s;
+				for( int r=0; r<_nedges; r++ ){
+
+					if( (*sol)[ r ] ) _mask[ r ] |= bit;
+
+				}
+
+			}
+
+			// Component membership: every cluster starts labelled by itself and 
+			// takes the label of its parent cluster wherever the joining edge is present
+			for( int c=0; c<_nclusters; c++ ){
+
+				int *label = _label + c * LANES;
+				for( int s=0; s<LANES; s++ ) label[ s ] = c;
+
+			}
+
+			for( int t=0; t<_num_tree_edges; t++ ){
+
+				uint64_t mask = _mask[ _tree_edge[ t ] ];
+				int *child = _label + _tree_child[ t ] * LANES;
+				int *parent = _label + _tree_parent[ t ] * LANES;
+				for( int s=0; s<LANES; s++ ) child[ s ] = ( (mask >> s) & 1 ) ? parent[ s ] : child[ s ];
+
+			}
+
+			// Cycle edges merge two already labelled components (relabel in affected lanes only)
+			for( int t=0; t<_num_cycle_edges; t++ ){
+
+				int r = _cycle_edge[ t ];
+				int *label1 = _label + _edge_end[ 2*r ] * LANES;
+				int *label2 = _label + _edge_end[ 2*r+1 ] * LANES;
+
+				for( int s=0; s<count; s++ ){
+
+					int from = label1[ s ], to = label2[ s ];
+					if( ( (_mask[ r ] >> s) & 1 ) && from != to ){
+
+						for( int c=0; c<_nclusters; c++ ){
+
+							if( _label[ c * LANES + s ] == from ) _label[ c * LANES + s ] = to;
+
+						}
+
+					}
+
+				}
+
+			}
+
+			// Number of clusters: components whose label is their own cluster
+			int kclusters[ LANES ];
+			for( int s=0; s<LANES; s++ ) kclusters[ s ] = 0;
+			for( int c=0; c<_nclusters; c++ ){
+
+				int *label = _label + c * LANES;
+				for( int s=0; s<LANES; s++ ) kclusters[ s ] += ( label[ s ] == c ) ? 1 : 0;
+
+			}
+
+			// Connectivity: subtract contributions of cluster pairs which end up in the same component
+			double connectivity[ LANES ];
+			for( int s=0; s<LANES; s++ ) connectivity[ s ] = _precomputed->_connectivity;
+			for( int i=0; i<_precomputed->_cnn_pairs; i++ ){
+
+				int c1 = _precomputed->_cnn_pair[ 2 * i ], c2 = _precomputed->_cnn_pair[ 2 * i + 1 ];
+				double contribution = _precomputed->_cnn_contribution[ i ];
+				int *label1 = _label + c1 * LANES;
+				int *label2 = _label + c2 * LANES;
+				for( int s=0; s<LANES; s++ ) connectivity[ s ] -= ( label1[ s ] == label2[ s ] ) ? contribution : 0.0;
+
+			}
+
+			// Variance: accumulate sizes and centroids of the final clusters
+			for( int i=0; i<count*_nclusters; i++ ) _size[ i ] = 0;
+			std::fill( _centre, _centre + size_t( count ) * _nclusters * mdim, 0.0f );
+
+			for( int c=0; c<_nclusters; c++ ){
+
+				int *label = _label + c * LANES;
+				int size = _precomputed->_size[ c ];
+				VectorFloatPtr centre = _precomputed->_centre[ c ];
+
+				for( int s=0; s<count; s++ ){
+
+					int m = s * _nclusters + label[ s ];
+					_size[ m ] += size;
+					for( int d=0; d<mdim; d++ ) _centre[ size_t( m ) * mdim + d ] += ( size * centre[ d ] );
+
+				}
+
+			}
+
+			for( int m=0; m<count*_nclusters; m++ ){
+
+		    	if( _size[ m ] > 1 )
+		    		divide_VectorFloat_by( _centre + size_t( m ) * mdim, float(_size[ m ]), _centre + size_t( m ) * mdim, mdim );
+
+			}
+
+			double variance[ LANES ];
+			for( int s=0; s<count; s++ ) variance[ s ] = _base_variance;
+			for( int c=0; c<_nclusters; c++ ){
+
+				int *label = _label + c * LANES;
+				int size = _precomputed->_size[ c ];
+
+				for( int s=0; s<count; s++ ){
+
+					double diff = PROBLEM->distance_measure( _precomputed->_centre[ c ], _centre + size_t( s * _nclusters + label[ s ] ) * mdim, mdim );
+			        variance[ s ] += size * ( diff * diff );
+
+				}
+
+			}
+
+			// Save evaluation information in solution objects
+			for( int s=0; s<count; s++ ){
+
+				SolutionPtr sol = (*population)[ first + s ];
+				sol->objective( 0 ) = ( variance[ s ] / PROBLEM->ndata() );
+				sol->objective( 1 ) = ( connectivity[ s ] > 0.00001 ) ? connectivity[ s ] : 0.0;
+				sol->kclusters() = kclusters[ s ];
+				sol->evaluation() = evaluations + s + 1;
+
+			}
+
+		}
+
+};
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -54,6 +54,7 @@ void EvaluatorFull::evaluate( SolutionPtr solution ){
 
     // Increase evaluations counter
     _total_evaluations++;
+    PROFILE_COUNT( EVALUATIONS, 1 );
 
     // Decode given solution and create clustering object
     ClusteringPtr clustering = solution->decode_clustering();
@@ -35,6 +35,11 @@ C/C++ libraries
 #include <vector>
 #include <fstream>
 #include <random>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <cstdlib>
+#include <climits>
 
 /******************
 Global constants 
@@ -58,6 +63,12 @@ using namespace std;
 
 #define DISTANCE_MEASURE EUCLIDEAN // Distance measure to use
 
+// Run report (<output>_run_report.json): 0 none (instrumentation compiled away), 
+// 1 phase timers and counters, 2 also a trace of every timed phase
+#ifndef PROFILE_LEVEL
+#define PROFILE_LEVEL 1
+#endif
+
 /******************
 Defined types
 ******************/
@@ -73,23 +84,27 @@ typedef VectorDoublePtr * MatrixDoublePtr;
 /******************
 Project libraries 
 ******************/
+#include "mock_Random.hh"
 #include "mock_Util.hh"
+#include "mock_Profiler.hh"
+#include "mock_Context.hh"
 #include "mock_ClusteringProblem.hh"
 #include "mock_Algorithm.fwd.hh"
 
 /******************
 Global variables 
 ******************/
-extern vector< vector< string > > input_parameters;	// List of command-line parameters (mock.hh)
-extern ClusteringProblemPtr PROBLEM;				// Pointer to PROBLEM object (mock.hh)
-extern AlgorithmPtr ALGO;							// Pointer to ALGORITHM object (mock.hh)
-extern default_random_engine *rnd;					// Random numbers generator (mock.hh)
+// Settings and state of the job of the calling thread (see mock_Context.hh)
+#define input_parameters ( Context::current()->parameters )	// List of command-line parameters
+#define PROBLEM ( Context::current()->problem )				// Pointer to PROBLEM object
+#define ALGO ( Context::current()->algorithm )				// Pointer to ALGORITHM object
+extern thread_local RandomPtr rnd;					// Random numbers generator, one per thread (mock_Context.cc)
 
 // Mock-specific parameters
-extern int mock_L;							// Number of nearest neighbours to use in mutation and connectivity computation
-extern int mock_Kmax;						// Upper bound on the number of clusters k generated by k-means during initialisation
-extern const int num_objectives;			// Number of optimisation objectives to use	
-extern int TOTAL_INITIAL_SOLUTIONS;			// Size of the initial set of solutions
+#define mock_L ( Context::current()->L )							// Number of nearest neighbours to use in mutation and connectivity computation
+#define mock_Kmax ( Context::current()->Kmax )						// Upper bound on the number of clusters k generated by k-means during initialisation
+extern const int num_objectives;			// Number of optimisation objectives to use	(mock_Context.cc)
+#define TOTAL_INITIAL_SOLUTIONS ( Context::current()->initial_solutions )	// Size of the initial set of solutions
 /******************/
 
 #endif
@@ -0,0 +1,170 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Hypervolume.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+Hypervolume::Hypervolume(){
+
+	_reference[ 0 ] = _reference[ 1 ] = 0.0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reference point: worst value of each objective in the given population plus 10% of its range
+// (or of its magnitude if all values are equal), so that extreme solutions also contribute
+void Hypervolume::set_reference( PopulationPtr pop ){
+
+	for( int m = 0; m < 2; m++ ){
+
+		double low = (*pop)[ 0 ]->objective( m ), high = low;
+
+		for( int i = 1; i < pop->size(); i++ ){
+
+			low = min( low, (*pop)[ i ]->objective( m ) );
+			high = max( high, (*pop)[ i ]->objective( m ) );
+
+		}
+
+		double range = ( high > low ) ? high - low : max( fabs( high ), 1.0 );
+		_reference[ m ] = high + 0.1 * range;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Hypervolume of the rank-1 solutions of the given (ranked) population
+// Sweep in ascending order of the first objective (descending order of the second one):
+// each solution adds the rectangle between itself, the previous solution and the reference point
+double Hypervolume::compute( PopulationPtr pop ){
+
+	_points.clear();
+
+	for( int i = 0; i < pop->size(); i++ ){
+
+		SolutionPtr sol = (*pop)[ i ];
+		if( sol->rank() == 1 && sol->objective( 0 ) < _reference[ 0 ] && sol->objective( 1 ) < _reference[ 1 ] ){
+
+			_points.push_back( std::make_pair( sol->objective( 0 ), sol->objective( 1 ) ) );
+
+		}
+
+	}
+
+	std::sort( _points.begin(), _points.end() );
+
+	double hv = 0.0, previous = _reference[ 1 ];
+
+	for( int i = 0; i < int( _points.size() ); i++ ){
+
+		if( _points[ i ].second < previous ){
+
+			hv += ( _reference[ 0 ] - _points[ i ].first ) * ( previous - _points[ i ].second );
+			previous = _points[ i ].second;
+
+		}
+
+	}
+
+	return hv;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Adds a record to the trace
+void Hypervolume::record( int generation, unsigned long evaluations, double hv ){
+
+	_generation.push_back( generation );
+	_evaluations.push_back( evaluations );
+	_hv.push_back( hv );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Relative gain over the last 'window' records below epsilon?
+bool Hypervolume::converged( double epsilon, int window ){
+
+	int n = size();
+	if( window < 1 || n <= window ) return false;
+
+	double before = _hv[ n-1-window ], now = _hv[ n-1 ];
+	if( before <= 0.0 ) return false;
+
+	return ( now - before ) / before < epsilon;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Output trace: generation, evaluations, hypervolume (one line per record)
+void Hypervolume::write( string filename ){
+
+	ofstream file( filename );
+
+	file.precision( 12 );
+	for( int i = 0; i < size(); i++ ){
+
+		file << _generation[ i ] << "\t" << _evaluations[ i ] << "\t" << _hv[ i ] << endl;
+
+	}
+
+	file.close();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Checkpoint: reference point and trace
+void Hypervolume::put( Checkpoint & checkpoint ){
+
+	checkpoint.put< double >( _reference[ 0 ] );
+	checkpoint.put< double >( _reference[ 1 ] );
+	checkpoint.put< int32_t >( size() );
+
+	for( int i = 0; i < size(); i++ ){
+
+		checkpoint.put< int32_t >( _generation[ i ] );
+		checkpoint.put< uint64_t >( _evaluations[ i ] );
+		checkpoint.put< double >( _hv[ i ] );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Restart: reference point and trace
+void Hypervolume::get( Checkpoint & checkpoint ){
+
+	_reference[ 0 ] = checkpoint.get< double >();
+	_reference[ 1 ] = checkpoint.get< double >();
+
+	int n = checkpoint.get< int32_t >();
+	_generation.clear();
+	_evaluations.clear();
+	_hv.clear();
+
+	for( int i = 0; i < n; i++ ){
+
+		int generation = checkpoint.get< int32_t >();
+		unsigned long evaluations = checkpoint.get< uint64_t >();
+		record( generation, evaluations, checkpoint.get< double >() );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,92 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_HYPERVOLUME_HH__
+#define __MOCK_HYPERVOLUME_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Hypervolume.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Population.hh"
+#include "mock_Checkpoint.hh"
+
+/******************
+Class definition
+******************/
+
+// Hypervolume (two objectives, minimisation) of the rank-1 solutions of a population, 
+// tracked along the search with respect to a fixed reference point
+// Used to report convergence (trace) and to stop the search once the front stops improving
+class Hypervolume{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		double _reference[ 2 ];					// Reference point
+
+		vector< int > _generation;				// Trace: generation,
+		vector< unsigned long > _evaluations;	// 		  evaluations,
+		vector< double > _hv;					// 		  hypervolume
+
+		vector< std::pair< double, double > > _points;	// Auxiliary: objective vectors of the rank-1 solutions
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor
+		Hypervolume();
+
+		// Reference point: worst value of each objective in the given population plus 10% of its range
+		void set_reference( PopulationPtr pop );
+
+		// Hypervolume of the rank-1 solutions of the given (ranked) population
+		double compute( PopulationPtr pop );
+
+		// Trace
+		void record( int generation, unsigned long evaluations, double hv );
+		int size(){ return int( _hv.size() ); }
+		double last(){ return _hv.back(); }
+
+		// Relative gain over the last 'window' records below epsilon?
+		bool converged( double epsilon, int window );
+
+		// Output trace: generation, evaluations, hypervolume (one line per record)
+		void write( string filename );
+
+		// Checkpoint/restart
+		void put( Checkpoint & checkpoint );
+		void get( Checkpoint & checkpoint );
+
+};
+
+#endif
@@ -0,0 +1,351 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_IslandModel.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+MigrantRing::MigrantRing( int capacity, int length ) :
+
+	_capacity( capacity ),
+	_length( length ),
+	_head( 0 ),
+	_tail( 0 ),
+	_batches( 0 ),
+	_consumed( 0 ),
+	_limit( 0 ),
+	_producer_done( false ),
+	_consumer_done( false )
+
+{
+
+	// Allocate memory
+	_encoding = allocate_MatrixInt( _capacity, _length, "islands" );
+	_objective = allocate_MatrixDouble( _capacity, num_objectives, "islands" );
+	_kclusters = allocate_VectorInt( _capacity, "islands" );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+MigrantRing::~MigrantRing(){
+
+	// Deallocate memory
+	deallocate_MatrixInt( _encoding, _capacity );
+	deallocate_MatrixDouble( _objective, _capacity );
+	deallocate_VectorInt( _kclusters );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Producer: copy solution into the ring (false if the ring is full)
+// Waits for a free slot unless the consumer has finished
+bool MigrantRing::push( SolutionPtr sol ){
+
+	unsigned long tail = _tail.load( std::memory_order_relaxed );
+	while( tail - _head.load( std::memory_order_acquire ) == (unsigned long)( _capacity ) ){
+
+		if( _consumer_done.load( std::memory_order_acquire ) ) return false;
+		std::this_thread::yield();
+
+	}
+
+	int slot = int( tail % _capacity );
+	for( int i = 0; i < _length; i++ ) _encoding[ slot ][ i ] = (*sol)[ i ];
+	for( int m = 0; m < num_objectives; m++ ) _objective[ slot ][ m ] = sol->objective( m );
+	_kclusters[ slot ] = sol->kclusters();
+
+	// Publish slot
+	_tail.store( tail + 1, std::memory_order_release );
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Consumer: overwrite the given solution with the oldest migrant (false if the ring is empty)
+// Only migrants of the current batch are returned
+bool MigrantRing::pop( SolutionPtr sol ){
+
+	unsigned long head = _head.load( std::memory_order_relaxed );
+	if( head == _limit ) return false;
+
+	int slot = int( head % _capacity );
+	for( int i = 0; i < _length; i++ ) (*sol)[ i ] = _encoding[ slot ][ i ];
+	for( int m = 0; m < num_objectives; m++ ) sol->objective( m ) = _objective[ slot ][ m ];
+	sol->kclusters() = _kclusters[ slot ];
+
+	// Release slot
+	_head.store( head + 1, std::memory_order_release );
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Producer: closes the current batch (waits until the consumer has started reading the 
+// oldest pending batch, unless it has finished)
+void MigrantRing::end_batch(){
+
+	unsigned long batches = _batches.load( std::memory_order_relaxed );
+	while( batches >= _consumed.load( std::memory_order_acquire ) + BATCHES ){
+
+		if( _consumer_done.load( std::memory_order_acquire ) ) return;
+		std::this_thread::yield();
+
+	}
+
+	_batch_end[ batches % BATCHES ] = _tail.load( std::memory_order_relaxed );
+	_batches.store( batches + 1, std::memory_order_release );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Consumer: waits for the next batch (or for the producer to finish); migrants of the 
+// previous batch that were not read are discarded
+void MigrantRing::begin_batch(){
+
+	// Discard the rest of the previous batch
+	if( _head.load( std::memory_order_relaxed ) != _limit ) _head.store( _limit, std::memory_order_release );
+
+	unsigned long consumed = _consumed.load( std::memory_order_relaxed );
+	while( _batches.load( std::memory_order_acquire ) <= consumed ){
+
+		if( _producer_done.load( std::memory_order_acquire ) && _batches.load( std::memory_order_acquire ) <= consumed ) return;
+		std::this_thread::yield();
+
+	}
+
+	_limit = _batch_end[ consumed % BATCHES ];
+	_consumed.store( consumed + 1, std::memory_order_release );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+IslandModel::IslandModel( int islands ) : 
+
+	Algorithm( "islands" ),
+	_num_islands( islands )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+IslandModel::~IslandModel(){
+
+	// Deallocate memory
+	for( int i = 0; i < _num_islands; i++ ){
+
+		delete _islands[ i ];
+		delete _rings[ i ];
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void IslandModel::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_migration_interval = 10;
+	_migrants = 5;
+	_out_filename = "";
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--migration") ){
+
+			// Generations between migrations (0: isolated islands)
+			_migration_interval = stoi( value );
+
+		}else if( (option == "--migrants") ){
+
+			// Number of migrants
+			_migrants = stoi( value );
+
+		}else if( (option == "--output") ){
+
+			// Output filename
+			_out_filename = value;
+
+		}else if( (option == "--steadystate") && (value == "true") ){
+
+			error_message_exit( "The steady-state variant cannot be used in island mode (--steadystate, --islands)" );
+
+		}else if( (option == "--checkpoint") || (option == "--resume") ){
+
+			error_message_exit( "Checkpoints are not supported in island mode (--checkpoint, --resume)" );
+
+		}
+
+	}	
+
+	// Configure method
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configuration of search algorithm based on input and default parameters
+void IslandModel::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _num_islands < 2 ) error_message_exit( "At least two islands are required (--islands)" );
+	if( _migrants < 0 ) error_message_exit( "Number of migrants cannot be negative (--migrants)" );
+
+	// Islands are configured from the same command-line parameters
+	// (one thread per island: offspring of each island are generated serially)
+	for( int i = 0; i < _num_islands; i++ ){
+
+		_islands.push_back( Nsga2::create() );
+		_islands[ i ]->set_threads( 1 );
+
+	}
+
+	// Shared problem information must be set up before islands run concurrently
+	_islands[ 0 ]->prepare_problem();
+
+	// Migration rings (room for two migrations)
+	for( int i = 0; i < _num_islands; i++ ){
+
+		_rings.push_back( new MigrantRing( max( 1, 2 * _migrants ), _islands[ 0 ]->encoding_length() ) );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine
+void IslandModel::run(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Running " + _algorithm_name << " (" << _num_islands << " islands)" << endl;
+	#endif	
+
+	// Islands' random number generators are independent streams of the main generator,
+	// identified by the island index (jump-ahead)
+	vector< Random > island_rnd;
+	for( int i = 0; i < _num_islands; i++ ) island_rnd.push_back( rnd->stream( i ) );
+
+	// Evolve islands
+	vector< std::thread > threads;
+	for( int i = 0; i < _num_islands; i++ ){
+
+		threads.push_back( std::thread( &IslandModel::run_island, this, i, island_rnd[ i ], Context::current() ) );
+
+	}
+
+	for( int i = 0; i < _num_islands; i++ ) threads[ i ].join();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Evolution of the i-th island (thread routine)
+void IslandModel::run_island( int i, Random island_rnd, ContextPtr context ){
+
+	// Each thread runs in the context of the model, with its own random numbers generator
+	Context::Scope scope( context, false );
+	rnd = RandomPtr( new Random( island_rnd ) );
+
+	Nsga2 * island = _islands[ i ];
+	MigrantRingPtr outgoing = _rings[ i ];
+	MigrantRingPtr incoming = _rings[ ( i + _num_islands - 1 ) % _num_islands ];
+
+	island->start();
+
+	while( !island->finished() ){
+
+		island->step();
+
+		// Migration
+		if( _migration_interval > 0 && island->generation() % _migration_interval == 0 ){
+
+			island->emigrate( outgoing, _migrants );
+			outgoing->end_batch();
+
+			incoming->begin_batch();
+			island->immigrate( incoming );
+
+		}
+
+	}
+
+	// Neighbours must not wait for this island any longer
+	outgoing->close_producer();
+	incoming->close_consumer();
+
+	delete rnd;
+	rnd = nullptr;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reports results - generates output files
+// The final populations of all islands are merged, and the nondominated solutions reported
+void IslandModel::generate_output( int g ){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Generating output files" << endl;
+	#endif
+
+	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
+
+	// Merge populations (solutions are not copied)
+	int total = 0;
+	for( int i = 0; i < _num_islands; i++ ) total += _islands[ i ]->population()->size();
+
+	PopulationPtr merged = PopulationPtr( new Population( total ) );
+	for( int i = 0; i < _num_islands; i++ ){
+
+		PopulationPtr pop = _islands[ i ]->population();
+		for( int j = 0; j < pop->size(); j++ ) merged->add( (*pop)[ j ] );
+
+	}
+
+	{
+		PROFILE_PHASE( "output" );
+		OutputWriter::write_nondominated( merged, _out_filename, g != -1 );
+	}
+
+	// Free memory (solutions belong to the islands)
+	merged->clear();
+	delete merged;
+
+	// Run report (phases and counters of all islands)
+	#if PROFILE_LEVEL > 0
+		Profiler::current().write( _out_filename + "_run_report.json" );
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_ISLANDMODEL_HH__
+#define __MOCK_ISLANDMODEL_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_IslandModel.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Algorithm.hh"
+#include "mock_Nsga2.hh"
+#include <atomic>
+#include <thread>
+
+/******************
+Class definition
+******************/
+
+// Interface to exchange migrants between populations
+// Migrants are copies of the genotype and objective values of solutions, so that 
+// populations never share solution objects
+class MigrantBuffer{
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		virtual ~MigrantBuffer(){ /* do nothing */ }
+
+		// Copy solution into the buffer (false if the buffer is full)
+		virtual bool push( SolutionPtr sol ) = 0;
+
+		// Overwrite the given solution with the oldest migrant (false if the buffer is empty)
+		virtual bool pop( SolutionPtr sol ) = 0;
+
+};
+
+// Bounded single-producer/single-consumer ring of migrants (lock-free)
+// Slots are allocated once, at construction. Migrants are grouped in batches (one per migration):
+// the consumer waits for the next complete batch and only reads its migrants, and the producer
+// waits for free slots, so the exchange does not depend on the relative speed of the islands
+class MigrantRing : public MigrantBuffer {
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		int _capacity;							// Number of slots
+
+		int _length;							// Encoding length of the migrants
+
+		MatrixIntPtr _encoding;					// Genotype of the migrant in each slot
+
+		MatrixDoublePtr _objective;				// Objective values of the migrant in each slot
+
+		VectorIntPtr _kclusters;				// Number of clusters of the migrant in each slot
+
+		std::atomic< unsigned long > _head;		// Next slot to be read (written by consumer only)
+
+		std::atomic< unsigned long > _tail;		// Next slot to be written (written by producer only)
+
+		static const int BATCHES = 2;			// Maximum number of complete batches not yet read
+
+		unsigned long _batch_end[ BATCHES ];	// Value of _tail at the end of each pending batch
+
+		std::atomic< unsigned long > _batches;	// Number of complete batches (written by producer only)
+
+		std::atomic< unsigned long > _consumed;	// Number of batches started (written by consumer only)
+
+		unsigned long _limit;					// End of the batch being read (consumer only)
+
+		std::atomic< bool > _producer_done;		// Producer will not send more batches
+
+		std::atomic< bool > _consumer_done;		// Consumer will not read more batches
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor / destructor
+		MigrantRing( int capacity, int length );
+		~MigrantRing();
+
+		// Producer: copy solution into the ring (false if the ring is full)
+		virtual bool push( SolutionPtr sol );
+
+		// Consumer: overwrite the given solution with the oldest migrant (false if the ring is empty)
+		virtual bool pop( SolutionPtr sol );
+
+		// Producer: the migrants pushed since the last call form a batch / no more batches
+		void end_batch();
+		void close_producer(){ _producer_done.store( true, std::memory_order_release ); }
+
+		// Consumer: wait for the next batch (pop() only returns its migrants) / no more batches
+		void begin_batch();
+		void close_consumer(){ _consumer_done.store( true, std::memory_order_release ); }
+
+};
+
+// Island model: several Nsga2 populations evolved on separate threads
+// All islands share the (read-only) problem instance. Every _migration_interval generations,
+// each island sends copies of some of its rank-1 individuals to the next island (ring topology)
+// and replaces its worst individuals with those received from the previous one (sent at the same
+// generation, so results do not depend on thread scheduling). The final populations are merged
+// into a single output
+class IslandModel : public Algorithm {
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		int _num_islands;					// Number of islands (threads)
+
+		vector< Nsga2 * > _islands;			// Populations
+
+		vector< MigrantRingPtr > _rings;	// _rings[ i ]: migrants from island i to island i+1
+
+		int _migration_interval;			// Generations between migrations
+
+		int _migrants;						// Number of migrants sent by each island per migration
+
+		string _out_filename;				// Name of output file(s)
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+		// Evolution of a single island (thread routine)
+		void run_island( int i, Random island_rnd, ContextPtr context );
+
+	public:
+
+		// Constructor / destructor
+		IslandModel( int islands );
+		virtual ~IslandModel();
+
+		// Main execution routine
+		virtual void run();
+
+		// Output generation (merged nondominated solutions of all islands)
+		virtual void generate_output( int g = -1 );
+
+};
+
+#endif
@@ -0,0 +1,135 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Job.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+Job::Job( const vector< std::pair< string, string > > & parameters, ClusteringProblemPtr shared ) : 
+
+	_shared( shared )
+
+{
+
+	for( int i = 0; i < int( parameters.size() ); i++ ){
+
+		_context.set( parameters[ i ].first, parameters[ i ].second );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+Job::~Job(){
+
+	Context::Scope scope( &_context );
+
+	delete ALGO;
+	delete PROBLEM;
+	delete rnd;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Loads settings and data (once)
+void Job::load(){
+
+	Context::Scope scope( &_context );
+
+	if( PROBLEM != nullptr ) return;
+
+	initialise_random( _context.seed );
+	if( _shared != nullptr ) PROBLEM = ClusteringProblemPtr( new ClusteringProblem( _shared ) );
+	else PROBLEM = ClusteringProblemPtr( new ClusteringProblem( false ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Pre-computations (once)
+void Job::precompute(){
+
+	load();
+
+	Context::Scope scope( &_context );
+	PROBLEM->precompute();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Runs the search algorithm (NSGA-II, with the chosen representation)
+void Job::run(){
+
+	precompute();
+
+	Context::Scope scope( &_context );
+
+	delete ALGO;
+	ALGO = AlgorithmPtr( Nsga2::create() );
+	ALGO->run();
+
+	_front.clear();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Rank-1 solutions of the final population (empty until run)
+// Solutions are decoded and evaluated on first request
+const vector< Job::Solution > & Job::front(){
+
+	Context::Scope scope( &_context );
+
+	if( ALGO == nullptr || !_front.empty() ) return _front;
+
+	vector< SolutionPtr > rank1;
+	static_cast< Nsga2 * >( ALGO )->front( rank1 );
+
+	EvaluatorFull evaluator;
+	_front.assign( rank1.size(), Solution() );
+
+	for( int i = 0; i < int( rank1.size() ); i++ ){
+
+		ClusteringPtr clustering = rank1[ i ]->decode_clustering();
+
+		_front[ i ].variance = evaluator.variance( clustering );
+		_front[ i ].connectivity = evaluator.connectivity( clustering );
+		_front[ i ].clusters = clustering->total_clusters();
+		_front[ i ].ari = PROBLEM->labels_provided() ? evaluator.adjusted_rand_index( clustering ) : 0.0;
+
+		_front[ i ].labels.resize( PROBLEM->ndata() );
+		for( int j = 0; j < PROBLEM->ndata(); j++ ) _front[ i ].labels[ j ] = clustering->assignment( j );
+
+		delete clustering;
+
+	}
+
+	return _front;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes the output files
+void Job::write(){
+
+	Context::Scope scope( &_context );
+
+	if( ALGO != nullptr ) ALGO->generate_output();
+
+}
+////////////////////////////////////////////////////////////////////////////////
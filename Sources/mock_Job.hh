@@ -0,0 +1,112 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_JOB_HH__
+#define __MOCK_JOB_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Job.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Nsga2.hh"
+
+/******************
+Class definition
+******************/
+
+// Clustering job: library interface to Delta-MOCK (libdeltamock.a)
+// A job holds its own context (parameters, problem, algorithm, random numbers generator and
+// run report), so that several jobs can be run concurrently, each on its own thread:
+//     Job job( { { "--file", "data.txt" }, { "--seed", "1" } } );
+//     job.load(); job.precompute(); job.run();
+//     const vector< Job::Solution > & front = job.front();
+// Parameters are the command-line options of delta_mock (island and process models excepted)
+// NOTE: errors in the settings or data still terminate the process (error_message_exit)
+class Job{
+
+	public:
+
+		// A nondominated clustering solution
+		struct Solution{
+
+			double variance;			// Objective values
+			double connectivity;
+			int clusters;				// Number of clusters
+			double ari;					// Adjusted Rand Index (if labels provided, 0 otherwise)
+			vector< int > labels;		// Cluster label of each data element
+
+		};
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		Context _context;				// Settings and state of the job
+
+		ClusteringProblemPtr _shared;	// Problem instance whose data and pre-computations are shared (if any)
+
+		vector< Solution > _front;		// Rank-1 solutions of the final population
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor / destructor
+		// Jobs on the same data set may share the data and pre-computations of a problem instance
+		// (loaded and pre-computed, it must outlive them; see ClusteringProblem::share)
+		Job( const vector< std::pair< string, string > > & parameters, ClusteringProblemPtr shared = nullptr );
+		~Job();
+
+		// Loads settings and data, and plans the storage of pre-computed structures
+		void load();
+
+		// Pre-computations (distance matrix, nearest neighbours, MST)
+		void precompute();
+
+		// Runs the search algorithm
+		void run();
+
+		// Rank-1 solutions of the final population
+		const vector< Solution > & front();
+
+		// Writes the output files (--output), as delta_mock does
+		void write();
+
+		// Problem instance (after load)
+		ClusteringProblemPtr problem(){ return _context.problem; }
+
+		// Errors throw std::runtime_error instead of ending the process (false by default)
+		// NOTE: only errors raised on the calling thread; objects being built when an error
+		// is raised may not be released
+		void set_recoverable( bool recoverable ){ _context.recoverable = recoverable; }
+
+};
+
+#endif
@@ -0,0 +1,422 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_KMeans.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+// Keeps a contiguous copy of the data set of the problem
+KMeans::KMeans( int batch_size, int max_iterations ) :
+	_ndata( PROBLEM->ndata() ),
+	_mdim( PROBLEM->mdim() ),
+	_batch_size( batch_size ),
+	_max_iterations( max_iterations )
+{
+
+	_data.resize( size_t( _ndata ) * _mdim );
+
+	for( int i = 0; i < _ndata; i++ ){
+
+		VectorFloatPtr x = (*PROBLEM)[ i ];
+		for( int m = 0; m < _mdim; m++ ) _data[ size_t( i ) * _mdim + m ] = x[ m ];
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Applies body( first, last ) to consecutive chunks of [0, n)
+// Chunks have a fixed size, so results do not depend on the number of threads
+void KMeans::chunks( ThreadPoolPtr pool, const int n, std::function< void( int, int ) > body ){
+
+	const int size = 1024;
+	const int count = ( n + size - 1 ) / size;
+
+	auto chunk = [ n, size, &body ]( int c, int worker ){
+
+		body( c * size, ( n - c * size < size ) ? n : ( c + 1 ) * size );
+
+	};
+
+	if( pool != nullptr && count > 1 ) pool->parallel_for( count, chunk );
+	else for( int c = 0; c < count; c++ ) chunk( c, 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Closest (best, at distance d1) and second closest (at distance d2) centres of data point i
+void KMeans::nearest( const int i, const vector< double > & centres, const int k, int & best, double & d1, double & d2 ) const{
+
+	best = 0;
+	d1 = d2 = INFINITY;
+
+	for( int j = 0; j < k; j++ ){
+
+		double d = distance( i, &centres[ size_t( j ) * _mdim ] );
+
+		if( d < d1 ){
+
+			d2 = d1;
+			d1 = d;
+			best = j;
+
+		}else if( d < d2 ){
+
+			d2 = d;
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// k-means++ seeding: first centre chosen uniformly at random, each further centre chosen with 
+// probability proportional to the squared distance to the closest centre already chosen
+void KMeans::seeding( const int k, vector< double > & centres, ThreadPoolPtr pool ) const{
+
+	centres.assign( size_t( k ) * _mdim, 0.0 );
+	vector< double > closest( _ndata );
+
+	int chosen = rnd->uniform_int( 0, _ndata - 1 );
+
+	for( int c = 0; c < k; c++ ){
+
+		double * centre = &centres[ size_t( c ) * _mdim ];
+		for( int m = 0; m < _mdim; m++ ) centre[ m ] = _data[ size_t( chosen ) * _mdim + m ];
+
+		// Squared distance of each point to its closest centre
+		chunks( pool, _ndata, [ & ]( int first, int last ){
+
+			for( int i = first; i < last; i++ ){
+
+				double d = distance( i, centre );
+				closest[ i ] = ( c == 0 ) ? d * d : min( closest[ i ], d * d );
+
+			}
+
+		});
+
+		if( c == k - 1 ) break;
+
+		// Next centre (uniformly at random if all points coincide with the centres)
+		double total = 0.0;
+		for( int i = 0; i < _ndata; i++ ) total += closest[ i ];
+
+		if( total > 0.0 ){
+
+			double r = rnd->uniform() * total;
+			chosen = -1;
+
+			for( int i = 0; i < _ndata && chosen < 0; i++ ){
+
+				r -= closest[ i ];
+				if( r < 0.0 && closest[ i ] > 0.0 ) chosen = i;
+
+			}
+
+			// Rounding: last point with positive weight
+			for( int i = _ndata - 1; chosen < 0; i-- ) if( closest[ i ] > 0.0 ) chosen = i;
+
+		}else{
+
+			chosen = rnd->uniform_int( 0, _ndata - 1 );
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Lloyd iterations accelerated with Hamerly's bounds: an upper bound on the distance of each point
+// to its centre, and a lower bound on the distance to any other centre. A point keeps its centre
+// without any distance computation whenever the upper bound does not exceed the lower bound, or half
+// the distance between its centre and the closest other centre
+void KMeans::hamerly( const int k, vector< double > & centres, vector< int > & labels, ThreadPoolPtr pool ) const{
+
+	vector< double > upper( _ndata ), lower( _ndata ), half( k ), moved( k ), sums( size_t( k ) * _mdim );
+	vector< int > count( k );
+	vector< char > changed( _ndata );
+
+	// Initial assignment
+	chunks( pool, _ndata, [ & ]( int first, int last ){
+
+		for( int i = first; i < last; i++ ) nearest( i, centres, k, labels[ i ], upper[ i ], lower[ i ] );
+
+	});
+
+	for( int iteration = 0; iteration < _max_iterations; iteration++ ){
+
+		// Move centres to the mean of their points (empty clusters keep their centre)
+		std::fill( sums.begin(), sums.end(), 0.0 );
+		std::fill( count.begin(), count.end(), 0 );
+
+		for( int i = 0; i < _ndata; i++ ){
+
+			double * sum = &sums[ size_t( labels[ i ] ) * _mdim ];
+			for( int m = 0; m < _mdim; m++ ) sum[ m ] += _data[ size_t( i ) * _mdim + m ];
+			count[ labels[ i ] ]++;
+
+		}
+
+		int furthest = 0;
+		double max_moved = 0.0, second_moved = 0.0;
+
+		for( int j = 0; j < k; j++ ){
+
+			moved[ j ] = 0.0;
+			if( count[ j ] == 0 ) continue;
+
+			double * centre = &centres[ size_t( j ) * _mdim ];
+			double * sum = &sums[ size_t( j ) * _mdim ];
+			for( int m = 0; m < _mdim; m++ ) sum[ m ] /= count[ j ];
+			moved[ j ] = distance( centre, sum, _mdim );
+			std::copy( sum, sum + _mdim, centre );
+
+			if( moved[ j ] > max_moved ){
+
+				second_moved = max_moved;
+				max_moved = moved[ j ];
+				furthest = j;
+
+			}else if( moved[ j ] > second_moved ){
+
+				second_moved = moved[ j ];
+
+			}
+
+		}
+
+		if( max_moved == 0.0 ) break;
+
+		// Half the distance of each centre to its closest centre
+		for( int j = 0; j < k; j++ ){
+
+			double closest = INFINITY;
+			for( int o = 0; o < k; o++ ){
+
+				if( o != j ) closest = min( closest, distance( &centres[ size_t( j ) * _mdim ], &centres[ size_t( o ) * _mdim ], _mdim ) );
+
+			}
+			half[ j ] = 0.5 * closest;
+
+		}
+
+		// Update bounds, reassign points whose bounds overlap
+		chunks( pool, _ndata, [ & ]( int first, int last ){
+
+			for( int i = first; i < last; i++ ){
+
+				int a = labels[ i ];
+				upper[ i ] += moved[ a ];
+				lower[ i ] -= ( a == furthest ) ? second_moved : max_moved;
+				changed[ i ] = 0;
+
+				double bound = max( half[ a ], lower[ i ] );
+				if( upper[ i ] <= bound ) continue;
+
+				upper[ i ] = distance( i, &centres[ size_t( a ) * _mdim ] );
+				if( upper[ i ] <= bound ) continue;
+
+				nearest( i, centres, k, labels[ i ], upper[ i ], lower[ i ] );
+				changed[ i ] = ( labels[ i ] != a );
+
+			}
+
+		});
+
+		if( std::find( changed.begin(), changed.end(), 1 ) == changed.end() ) break;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Mini-batch k-means (Sculley): each iteration assigns a random sample of points to their closest 
+// centres, and moves each centre towards its points with a per-centre learning rate
+// All points are finally assigned to their closest centre
+void KMeans::minibatch( const int k, vector< double > & centres, vector< int > & labels, ThreadPoolPtr pool ) const{
+
+	vector< int > count( k, 0 ), batch( _batch_size ), assigned( _batch_size );
+
+	for( int iteration = 0; iteration < _max_iterations; iteration++ ){
+
+		for( int s = 0; s < _batch_size; s++ ) batch[ s ] = rnd->uniform_int( 0, _ndata - 1 );
+
+		chunks( pool, _batch_size, [ & ]( int first, int last ){
+
+			double d1, d2;
+			for( int s = first; s < last; s++ ) nearest( batch[ s ], centres, k, assigned[ s ], d1, d2 );
+
+		});
+
+		for( int s = 0; s < _batch_size; s++ ){
+
+			int j = assigned[ s ];
+			double eta = 1.0 / ++count[ j ];
+			double * centre = &centres[ size_t( j ) * _mdim ];
+			const float * x = &_data[ size_t( batch[ s ] ) * _mdim ];
+
+			for( int m = 0; m < _mdim; m++ ) centre[ m ] += eta * ( x[ m ] - centre[ m ] );
+
+		}
+
+	}
+
+	chunks( pool, _ndata, [ & ]( int first, int last ){
+
+		double d1, d2;
+		for( int i = first; i < last; i++ ) nearest( i, centres, k, labels[ i ], d1, d2 );
+
+	});
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// k-means clustering: label of each data point
+// Mini-batch variant if a batch size (smaller than the data set) was given
+void KMeans::kmeans( int k, vector< int > & labels, ThreadPoolPtr pool ) const{
+
+	if( k > _ndata ) k = _ndata;
+	labels.assign( _ndata, 0 );
+	if( k < 2 ) return;
+
+	vector< double > centres;
+	seeding( k, centres, pool );
+
+	if( _batch_size > 0 && _batch_size < _ndata ) minibatch( k, centres, labels, pool );
+	else hamerly( k, centres, labels, pool );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// k-medoids clustering (pre-computed distance matrix): label of each data point
+// k-means++ seeding, then points are assigned to their closest medoid and each medoid is replaced by
+// the member of its cluster with the smallest sum of distances to the other members, until no medoid changes
+void KMeans::kmedoids( int k, vector< int > & labels, ThreadPoolPtr pool ) const{
+
+	if( k > _ndata ) k = _ndata;
+	labels.assign( _ndata, 0 );
+	if( k < 2 ) return;
+
+	// Seeding
+	vector< int > medoids( k );
+	vector< double > closest( _ndata );
+
+	medoids[ 0 ] = rnd->uniform_int( 0, _ndata - 1 );
+
+	for( int c = 0; c < k; c++ ){
+
+		chunks( pool, _ndata, [ & ]( int first, int last ){
+
+			for( int i = first; i < last; i++ ){
+
+				double d = PROBLEM->distance( i, medoids[ c ] );
+				closest[ i ] = ( c == 0 ) ? d * d : min( closest[ i ], d * d );
+
+			}
+
+		});
+
+		if( c == k - 1 ) break;
+
+		double total = 0.0;
+		for( int i = 0; i < _ndata; i++ ) total += closest[ i ];
+
+		int chosen = -1;
+
+		if( total > 0.0 ){
+
+			double r = rnd->uniform() * total;
+
+			for( int i = 0; i < _ndata && chosen < 0; i++ ){
+
+				r -= closest[ i ];
+				if( r < 0.0 && closest[ i ] > 0.0 ) chosen = i;
+
+			}
+
+			for( int i = _ndata - 1; chosen < 0; i-- ) if( closest[ i ] > 0.0 ) chosen = i;
+
+		}else{
+
+			chosen = rnd->uniform_int( 0, _ndata - 1 );
+
+		}
+
+		medoids[ c + 1 ] = chosen;
+
+	}
+
+	// Alternate assignment and medoid update
+	vector< vector< int > > members( k );
+	bool updated = true;
+
+	for( int iteration = 0; iteration < _max_iterations && updated; iteration++ ){
+
+		chunks( pool, _ndata, [ & ]( int first, int last ){
+
+			for( int i = first; i < last; i++ ){
+
+				double best = INFINITY;
+
+				for( int j = 0; j < k; j++ ){
+
+					double d = PROBLEM->distance( i, medoids[ j ] );
+					if( d < best ){ best = d; labels[ i ] = j; }
+
+				}
+
+			}
+
+		});
+
+		for( int j = 0; j < k; j++ ) members[ j ].clear();
+		for( int i = 0; i < _ndata; i++ ) members[ labels[ i ] ].push_back( i );
+
+		updated = false;
+		vector< char > changed( k, 0 );
+
+		auto update = [ & ]( int j, int worker ){
+
+			double best = INFINITY;
+			int medoid = medoids[ j ];
+
+			for( int candidate : members[ j ] ){
+
+				double sum = 0.0;
+				for( int o : members[ j ] ) sum += PROBLEM->distance( candidate, o );
+				if( sum < best ){ best = sum; medoid = candidate; }
+
+			}
+
+			changed[ j ] = ( medoid != medoids[ j ] );
+			medoids[ j ] = medoid;
+
+		};
+
+		if( pool != nullptr ) pool->parallel_for( k, update );
+		else for( int j = 0; j < k; j++ ) update( j, 0 );
+
+		for( int j = 0; j < k; j++ ) if( changed[ j ] ) updated = true;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_KMEANS_HH__
+#define __MOCK_KMEANS_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_KMeans.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_ClusteringProblem.hh"
+#include "mock_ThreadPool.hh"
+
+/******************
+Class definition
+******************/
+
+// Partitional clustering of the data set of the problem into k clusters (initial solutions)
+// k-means: k-means++ seeding followed by Lloyd iterations accelerated with Hamerly's bounds 
+// (triangle inequality: most points skip the distance computations to the centres), or 
+// mini-batch k-means (Sculley) for large data sets. k-medoids: k-means++ seeding and alternating
+// assignment/medoid update on the pre-computed distance matrix.
+// Methods are const (safe to run concurrently for different k values); random numbers are taken from
+// 'rnd', and assignment steps are spread over the given pool (if any) in fixed chunks of data points
+class KMeans{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		int _ndata;					// Number of data points
+
+		int _mdim;					// Number of dimensions
+
+		vector< float > _data;		// Data points (contiguous copy, row-major)
+
+		int _batch_size;			// Mini-batch size (0: full Lloyd iterations)
+
+		int _max_iterations;		// Maximum number of iterations (or mini-batches)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		double distance( const int i, const double * centre ) const;
+		static double distance( const double * a, const double * b, const int mdim );
+		void nearest( const int i, const vector< double > & centres, const int k, int & best, double & d1, double & d2 ) const;
+		void seeding( const int k, vector< double > & centres, ThreadPoolPtr pool ) const;
+		void hamerly( const int k, vector< double > & centres, vector< int > & labels, ThreadPoolPtr pool ) const;
+		void minibatch( const int k, vector< double > & centres, vector< int > & labels, ThreadPoolPtr pool ) const;
+		static void chunks( ThreadPoolPtr pool, const int n, std::function< void( int, int ) > body );
+
+	public:
+
+		// Constructor
+		KMeans( int batch_size = 0, int max_iterations = 100 );
+
+		// Cluster label (0..k-1) of each data point
+		void kmeans( int k, vector< int > & labels, ThreadPoolPtr pool = nullptr ) const;
+		void kmedoids( int k, vector< int > & labels, ThreadPoolPtr pool = nullptr ) const;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Euclidean distance between data point i and the given centre
+inline double KMeans::distance( const int i, const double * centre ) const{
+
+	const float * x = &_data[ size_t( i ) * _mdim ];
+	double sum = 0.0;
+
+	for( int m = 0; m < _mdim; m++ ){
+
+		double diff = x[ m ] - centre[ m ];
+		sum += diff * diff;
+
+	}
+
+	return sqrt( sum );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Euclidean distance between two centres
+inline double KMeans::distance( const double * a, const double * b, const int mdim ){
+
+	double sum = 0.0;
+
+	for( int m = 0; m < mdim; m++ ){
+
+		double diff = a[ m ] - b[ m ];
+		sum += diff * diff;
+
+	}
+
+	return sqrt( sum );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,328 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Memory.hh"
+#include "mock_Global.hh"
+#include "mock_ThreadPool.hh"
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>
+#include <sys/resource.h>
+
+std::mutex Memory::_mutex;
+const char * Memory::_names[ Memory::MAX_TAGS ] = {};
+std::atomic< int > Memory::_count( 0 );
+std::atomic< long long > Memory::_bytes[ Memory::MAX_TAGS ] = {};
+std::atomic< long long > Memory::_peak[ Memory::MAX_TAGS ] = {};
+
+////////////////////////////////////////////////////////////////////////////////
+// Index of the given tag (registered on first use; beyond MAX_TAGS, tags share the last entry)
+int Memory::tag( const char * name ){
+
+	int count = _count.load( std::memory_order_acquire );
+	for( int t = 0; t < count; t++ ) if( _names[ t ] == name || strcmp( _names[ t ], name ) == 0 ) return t;
+
+	std::lock_guard< std::mutex > lock( _mutex );
+
+	count = _count.load( std::memory_order_relaxed );
+	for( int t = 0; t < count; t++ ) if( strcmp( _names[ t ], name ) == 0 ) return t;
+	if( count == MAX_TAGS ) return MAX_TAGS - 1;
+
+	_names[ count ] = ( count == MAX_TAGS - 1 ) ? "other" : name;
+	_count.store( count + 1, std::memory_order_release );
+
+	return count;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Accounts for a block allocated/released by an owner
+void Memory::allocated( int tag, long long bytes ){
+
+	long long now = _bytes[ tag ].fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+	long long peak = _peak[ tag ].load( std::memory_order_relaxed );
+	while( now > peak && !_peak[ tag ].compare_exchange_weak( peak, now, std::memory_order_relaxed ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void Memory::released( int tag, long long bytes ){
+
+	_bytes[ tag ].fetch_sub( bytes, std::memory_order_relaxed );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Bytes in use (all tags)
+long long Memory::tracked(){
+
+	long long total = 0;
+	for( int t = 0; t < num_tags(); t++ ) total += bytes( t );
+	return total;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Bytes in use and peak bytes of each tag (in order of registration)
+void Memory::usage( std::vector< Usage > & tags ){
+
+	tags.clear();
+	for( int t = 0; t < num_tags(); t++ ) tags.push_back( { _names[ t ], bytes( t ), _peak[ t ].load( std::memory_order_relaxed ) } );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Peak resident set size of the process, in bytes (0 if unknown)
+long long Memory::peak_rss(){
+
+	struct rusage usage;
+	if( getrusage( RUSAGE_SELF, &usage ) != 0 ) return 0;
+	
+	#ifdef __APPLE__
+		return usage.ru_maxrss;				// bytes
+	#else
+		return usage.ru_maxrss * 1024LL;	// kilobytes
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Physical memory of the machine, in bytes (0 if unknown)
+long long Memory::physical_memory(){
+
+	long pages = sysconf( _SC_PHYS_PAGES ), page_size = sysconf( _SC_PAGE_SIZE );
+	return ( pages > 0 && page_size > 0 ) ? (long long)( pages ) * page_size : 0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// One line per tag in use (e.g. for error messages)
+std::string Memory::summary(){
+
+	std::vector< Usage > tags;
+	usage( tags );
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision( 1 );
+	out << "Tracked memory (MB in use / peak), peak RSS " << peak_rss() / 1048576.0 << " MB:";
+	for( const Usage & u : tags ){
+
+		if( u.peak > 0 ) out << "\n\t" << u.tag << ": " << u.bytes / 1048576.0 << " / " << u.peak / 1048576.0;
+
+	}
+
+	return out.str();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Predicted peak bytes of each structure, by tag (the names used by the allocators), largest first
+// Settings are read from the command-line parameters; returns the total
+// NOTE: the number of pre-computed clusters of delta evaluation is that of relevant edges plus one
+// NOTE: the hash table of cluster pairs (sparse plan) is not allocated through the tracked allocators
+long long Memory::estimate( int ndata, int mdim, int islands, const Plan & plan, std::vector< Usage > & items ){
+
+	// Settings (defaults as in ClusteringProblem and Nsga2)
+	double delta = 0.0;
+	int population = 100, threads = 0, archive = 0;
+	string representation = "locus", labels = "files";
+	bool steady_state = false, selection = false;
+
+	for( int i = 0; i < int( input_parameters.size() ); i++ ){
+
+		string option = input_parameters[ i ][ 0 ], value = input_parameters[ i ][ 1 ];
+
+		if( option == "--delta" ) delta = min( max( stod( value ), 0.0 ), 100.0 );
+		else if( option == "--population" ) population = stoi( value );
+		else if( option == "--representation" ) representation = value;
+		else if( option == "--steadystate" ) steady_state = ( value == "true" );
+		else if( option == "--threads" ) threads = stoi( value );
+		else if( option == "--archive" ) archive = stoi( value );
+		else if( option == "--labels" ) labels = value;
+		else if( option == "--selection" ) selection = ( value == "true" );
+
+	}
+
+	typedef long long ll;
+	const ll n = ndata, d = mdim, L = mock_L, P = population;
+	const ll K = std::min( n, L + 1 );
+	const ll ptr = sizeof( void * );
+	const ll relevant = max( 1, int( ( 100.0 - delta ) / 100.0 * ( ndata - 1 ) ) );
+	const ll clusters = relevant + 1;
+	const ll pairs = std::min( n * L, clusters * ( clusters - 1 ) / 2 );
+	const ll length = ( representation == "locus" ) ? n : relevant;
+	const ll solutions = max( ll( TOTAL_INITIAL_SOLUTIONS ), 2 * P ) + archive;
+	const ll workers = ( steady_state ) ? ( threads > 0 ? threads : ll( ThreadPool::default_threads() ) ) : 1;
+	const bool delta_evaluation = ( representation != "locus" );
+
+	items.clear();
+	items.push_back( { "data", n * d * 4 + n * ptr + n * 4, 0 } );
+	if( plan.dense_distances ) items.push_back( { "distance_matrix", n * ( n + 1 ) / 2 * 4 + n * ptr, 0 } );
+	items.push_back( { "nearest_neighbours", n * ( plan.full_neighbours ? n : K ) * 4 + n * ptr + 2 * n * 8, 0 } );
+	items.push_back( { "neighbour_rank", plan.full_neighbours ? n * n * 4 + n * ptr : n * 4, 0 } );
+	items.push_back( { "mst", n * ( 4 + 16 + 4 + 4 + 4 + 1 ) + 2 * n * 4 + ( plan.full_neighbours ? 0 : n * ( 4 + 4 ) ), 0 } );
+
+	if( delta_evaluation ){
+
+		// Pre-computed cluster assignment (shared), and the structures of each evaluator
+		items.push_back( { "cluster_assignment", n * ( 4 + 4 * 4 + 8 ) + n * d * 4 + n * ptr, 0 } );
+		items.push_back( { "cnn_index", plan.dense_pairs ? clusters * clusters * 4 + clusters * ptr : pairs * 48, 0 } );
+		items.push_back( { "cnn_contribution", pairs * 8, 0 } );
+		items.push_back( { "cnn_pairs", pairs * 2 * 4, 0 } );
+
+		ll evaluator = clusters * ( 4 * 5 + ptr ) + clusters * d * 4 + n * ( 1 + 4 );
+		if( representation == "split" ) evaluator += relevant * ( 4 * 6 + 8 ) + 64 * clusters * ( 4 + 4 + d * 4 );
+		items.push_back( { "delta_evaluator", islands * workers * evaluator, 0 } );
+
+	}else{
+
+		items.push_back( { "clustering", islands * workers * ( n * 4 + n * d * 4 + n * 4 ), 0 } );
+
+	}
+
+	items.push_back( { "solutions", islands * solutions * ( length * 4 + num_objectives * 8 ), 0 } );
+	items.push_back( { "population_store", islands * 2 * P * ( ( length + 15 ) / 16 * 64 + num_objectives * 8 + 4 + 8 ), 0 } );
+	items.push_back( { "population", islands * 4 * solutions * ptr, 0 } );
+	items.push_back( { "nondominated_sorting", islands * 2 * P * ( 2 * 24 + 16 + 4 * 3 ), 0 } );
+	if( selection || labels != "files" ) items.push_back( { "labels", islands * P * n * 4, 0 } );
+
+	std::sort( items.begin(), items.end(), []( const Usage & a, const Usage & b ){ return a.bytes > b.bytes; } );
+
+	ll total = 0;
+	for( Usage & item : items ){
+
+		item.peak = item.bytes;
+		total += item.bytes;
+
+	}
+
+	return total;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes the estimated footprint for the data file and settings given (--estimate true)
+// Only the header of the data file (N, d) is read
+void Memory::estimate( std::ostream & out, int islands ){
+
+	string filename;
+	for( int i = 0; i < int( input_parameters.size() ); i++ ) if( input_parameters[ i ][ 0 ] == "--file" ) filename = input_parameters[ i ][ 1 ];
+
+	if( !ifstream( filename ) ) error_message_exit( "Error while trying to open file: " + filename );
+
+	int ndata, mdim;
+	if( !header( filename, ndata, mdim ) ) error_message_exit( "Invalid header of data file: " + filename );
+
+	std::vector< Usage > items;
+	Plan storage = plan( ndata, mdim, islands );
+	long long total = estimate( ndata, mdim, islands, storage, items );
+	long long physical = physical_memory();
+
+	out << std::fixed << std::setprecision( 1 );
+	out << "Estimated memory footprint (N = " << ndata << ", d = " << mdim << ", L = " << mock_L << ")" << endl;
+	out << "Storage plan: " << storage.describe() << endl;
+	for( const Usage & item : items ) out << "\t" << std::left << std::setw( 24 ) << item.tag << std::right << std::setw( 12 ) << item.bytes / 1048576.0 << " MB" << endl;
+	out << "\t" << std::left << std::setw( 24 ) << "total" << std::right << std::setw( 12 ) << total / 1048576.0 << " MB" << endl;
+
+	if( storage.limit > 0 && storage.limit != physical ) out << "\t" << std::left << std::setw( 24 ) << "memory limit" << std::right << std::setw( 12 ) << storage.limit / 1048576.0 << " MB" << endl;
+	if( physical > 0 ) out << "\t" << std::left << std::setw( 24 ) << "physical memory" << std::right << std::setw( 12 ) << physical / 1048576.0 << " MB" << endl;
+
+	if( storage.limit > 0 && total > storage.limit ) out << "WARNING: the estimated footprint exceeds the memory limit, even with the most compact storage" << endl;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Size (N) and dimensionality (d) from the header of a data file (false if unreadable or invalid)
+bool Memory::header( const string & filename, int & ndata, int & mdim ){
+
+	ndata = mdim = -1;
+
+	ifstream input( filename );
+	if( input ) input >> ndata >> mdim;
+
+	return ndata >= 2 && mdim >= 1;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Memory limit (--memory-limit: bytes, or with a k/m/g/t suffix, 0: none), by default the physical memory
+long long Memory::limit(){
+
+	for( int i = 0; i < int( input_parameters.size() ); i++ ){
+
+		if( input_parameters[ i ][ 0 ] != "--memory-limit" ) continue;
+
+		string value = input_parameters[ i ][ 1 ];
+		size_t end = 0;
+		double amount = -1.0;
+		try{ amount = stod( value, &end ); }catch( ... ){ end = 0; }
+
+		string unit = value.substr( end );
+		if( !unit.empty() && unit.back() == 'b' ) unit.pop_back();
+
+		long long scale = 0;
+		if( unit.empty() ) scale = 1;
+		else if( unit == "k" ) scale = 1LL << 10;
+		else if( unit == "m" ) scale = 1LL << 20;
+		else if( unit == "g" ) scale = 1LL << 30;
+		else if( unit == "t" ) scale = 1LL << 40;
+
+		if( end == 0 || amount < 0.0 || scale == 0 ) error_message_exit( "Invalid memory limit (--memory-limit): " + value );
+
+		return (long long)( amount * scale );
+
+	}
+
+	return physical_memory();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Storage strategy for the given problem size and settings
+// Everything is stored densely if it fits within the limit; otherwise, the structures are switched 
+// to compact storage in order of increasing cost for the search: the hash table of cluster pairs 
+// (pre-computation only), then the neighbour lists (ranks beyond L computed on demand, O(N)),
+// and finally the distance matrix (distances computed from the data on demand, O(d))
+Memory::Plan Memory::plan( int ndata, int mdim, int islands ){
+
+	std::vector< Usage > items;
+	Plan plan = { true, true, true, limit(), 0 };
+	plan.footprint = estimate( ndata, mdim, islands, plan, items );
+
+	bool Plan::* choices[] = { &Plan::dense_pairs, &Plan::full_neighbours, &Plan::dense_distances };
+	for( bool Plan::* choice : choices ){
+
+		if( plan.limit == 0 || plan.footprint <= plan.limit ) break;
+
+		plan.*choice = false;
+		plan.footprint = estimate( ndata, mdim, islands, plan, items );
+
+	}
+
+	return plan;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Short description of the plan (progress messages, estimate and run report)
+std::string Memory::Plan::describe() const{
+
+	std::ostringstream out;
+	out << "distances " << ( dense_distances ? "dense" : "on demand" );
+	out << ", neighbours " << ( full_neighbours ? "full" : "L nearest" );
+	out << ", cluster pairs " << ( dense_pairs ? "dense" : "hashed" );
+
+	return out.str();
+
+}
+////////////////////////////////////////////////////////////////////////////////
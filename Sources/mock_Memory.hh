@@ -0,0 +1,124 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_MEMORY_HH__
+#define __MOCK_MEMORY_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Memory.fwd.hh"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <iostream>
+
+/******************
+Class definition
+******************/
+
+// Memory accounting: bytes in use and peak bytes of the blocks allocated through the mock_Util 
+// allocators, by owner tag ("distance_matrix", "nearest_neighbours", "cluster_assignment"...),
+// plus the peak resident set size of the process
+// Up-front estimate (--estimate true): footprint of each structure predicted from the data file
+// header (N, d) and the settings (L, delta, population, representation...), before any allocation
+// Planner: storage strategy of the large pre-computed structures, chosen so that the estimated
+// footprint fits within the memory limit (--memory-limit, default: the physical memory)
+class Memory{
+
+	/******************
+	Types
+	******************/
+
+	public:
+
+		struct Usage{
+
+			std::string tag;
+			long long bytes;		// In use (estimate: predicted peak)
+			long long peak;
+
+		};
+
+		// Storage strategy of the structures whose size grows quadratically with N
+		struct Plan{
+
+			bool dense_distances;	// Distance matrix (otherwise, distances computed on demand from the data)
+			bool full_neighbours;	// Complete neighbour lists and rank matrix (otherwise, the L nearest neighbours only)
+			bool dense_pairs;		// Matrix of cluster pairs while pre-computing connectivity (otherwise, hash table)
+			long long limit;		// Memory limit (bytes, 0: none)
+			long long footprint;	// Estimated footprint under this plan
+
+			std::string describe() const;
+
+		};
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		static const int MAX_TAGS = 64;
+
+		static std::mutex _mutex;						// Registration of new tags
+		static const char * _names[ MAX_TAGS ];
+		static std::atomic< int > _count;
+		static std::atomic< long long > _bytes[ MAX_TAGS ];
+		static std::atomic< long long > _peak[ MAX_TAGS ];
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Accounting (tag indices are stored in the headers of the blocks)
+		static int tag( const char * name );
+		static void allocated( int tag, long long bytes );
+		static void released( int tag, long long bytes );
+
+		// Current state
+		static int num_tags(){ return _count.load(); }
+		static long long bytes( int tag ){ return _bytes[ tag ].load( std::memory_order_relaxed ); }
+		static long long tracked();
+		static void usage( std::vector< Usage > & tags );
+		static long long peak_rss();
+		static long long physical_memory();
+		static std::string summary();
+
+		// Up-front estimate of the footprint of a run (by tag, largest first)
+		static long long estimate( int ndata, int mdim, int islands, const Plan & plan, std::vector< Usage > & items );
+		static void estimate( std::ostream & out, int islands );
+		static bool header( const std::string & filename, int & ndata, int & mdim );
+
+		// Memory limit and storage strategy for the given problem size
+		static long long limit();
+		static Plan plan( int ndata, int mdim, int islands );
+
+};
+
+#endif
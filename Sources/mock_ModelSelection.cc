@@ -0,0 +1,245 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_ModelSelection.hh"
+#include <unordered_map>
+#include <numeric>
+
+////////////////////////////////////////////////////////////////////////////////
+// Model selection requested? (--selection)
+bool ModelSelection::enabled(){
+
+	bool selection = false;
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--selection" ) selection = ( input_parameters[ i ][ 1 ] == "true" );
+
+	}
+
+	return selection;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Knee score: distance of each solution below the line joining the extremes of the front,
+// objectives normalised to [0,1] (positive: the solution bulges towards the ideal point)
+void ModelSelection::knee( const vector< double > & variance, const vector< double > & connectivity, vector< double > & score ){
+
+	const int n = int( variance.size() );
+	double low[ 2 ] = { INFINITY, INFINITY }, high[ 2 ] = { -INFINITY, -INFINITY };
+
+	for( int i = 0; i < n; i++ ){
+
+		low[ 0 ] = min( low[ 0 ], variance[ i ] );
+		high[ 0 ] = max( high[ 0 ], variance[ i ] );
+		low[ 1 ] = min( low[ 1 ], connectivity[ i ] );
+		high[ 1 ] = max( high[ 1 ], connectivity[ i ] );
+
+	}
+
+	score.assign( n, 0.0 );
+
+	for( int i = 0; i < n; i++ ){
+
+		double x = ( high[ 0 ] > low[ 0 ] ) ? ( variance[ i ] - low[ 0 ] ) / ( high[ 0 ] - low[ 0 ] ) : 0.0;
+		double y = ( high[ 1 ] > low[ 1 ] ) ? ( connectivity[ i ] - low[ 1 ] ) / ( high[ 1 ] - low[ 1 ] ) : 0.0;
+		score[ i ] = ( 1.0 - x - y ) / sqrt( 2.0 );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Common refinement of the given solutions: component of each data element 
+// (elements share a component if they share a cluster in every solution)
+void ModelSelection::components( const vector< int32_t > & labels, const int n, vector< int > & component, int & count ){
+
+	const int ndata = PROBLEM->ndata();
+	component.assign( ndata, 0 );
+	count = 1;
+
+	std::unordered_map< long long, int > ids;
+	vector< int > refined( ndata );
+
+	for( int s = 0; s < n; s++ ){
+
+		const int32_t * row = &labels[ size_t( s ) * ndata ];
+		ids.clear();
+
+		for( int i = 0; i < ndata; i++ ){
+
+			long long key = ( (long long)( component[ i ] ) << 32 ) | (unsigned int)( row[ i ] );
+			std::unordered_map< long long, int >::iterator it = ids.find( key );
+
+			if( it == ids.end() ) it = ids.insert( std::make_pair( key, int( ids.size() ) ) ).first;
+			refined[ i ] = it->second;
+
+		}
+
+		component.swap( refined );
+		count = int( ids.size() );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Average silhouette width of each solution
+// s(i) = ( b(i) - a(i) ) / max( a(i), b(i) ), with a(i) the mean distance of element i to the other 
+// members of its cluster and b(i) the smallest mean distance to the members of another cluster
+// (s(i) = 0 for singletons; the silhouette of a single-cluster solution is 0)
+void ModelSelection::silhouette( const vector< int32_t > & labels, const int n, vector< double > & score, ThreadPoolPtr pool ){
+
+	const int ndata = PROBLEM->ndata();
+	score.assign( n, 0.0 );
+
+	// Components shared by all solutions; their distance sums are kept if not too large
+	vector< int > component;
+	int count;
+	components( labels, n, component, count );
+
+	const bool aggregated = ( double( ndata ) * count <= 32.0 * 1024 * 1024 );
+	vector< double > sums;
+
+	if( aggregated ){
+
+		// Distance sums of each element to each component
+		sums.assign( size_t( ndata ) * count, 0.0 );
+
+		auto row_sums = [ & ]( int i, int worker ){
+
+			double * row = &sums[ size_t( i ) * count ];
+			for( int j = 0; j < ndata; j++ ) if( j != i ) row[ component[ j ] ] += PROBLEM->distance( i, j );
+
+		};
+
+		if( pool != nullptr ) pool->parallel_for( ndata, row_sums );
+		else for( int i = 0; i < ndata; i++ ) row_sums( i, 0 );
+
+	}
+
+	auto solution = [ & ]( int s, int worker ){
+
+		const int32_t * row = &labels[ size_t( s ) * ndata ];
+
+		int k = 0;
+		for( int i = 0; i < ndata; i++ ) k = max( k, int( row[ i ] ) + 1 );
+		if( k < 2 ) return;
+
+		vector< int > size( k, 0 );
+		for( int i = 0; i < ndata; i++ ) size[ row[ i ] ]++;
+
+		// Cluster of each component
+		vector< int > cluster( aggregated ? count : 0 );
+		if( aggregated ) for( int i = 0; i < ndata; i++ ) cluster[ component[ i ] ] = row[ i ];
+
+		vector< double > distance( k );
+		double total = 0.0;
+
+		for( int i = 0; i < ndata; i++ ){
+
+			std::fill( distance.begin(), distance.end(), 0.0 );
+
+			if( aggregated ){
+
+				const double * element = &sums[ size_t( i ) * count ];
+				for( int c = 0; c < count; c++ ) distance[ cluster[ c ] ] += element[ c ];
+
+			}else{
+
+				for( int j = 0; j < ndata; j++ ) if( j != i ) distance[ row[ j ] ] += PROBLEM->distance( i, j );
+
+			}
+
+			const int own = row[ i ];
+			if( size[ own ] < 2 ) continue;
+
+			double a = distance[ own ] / ( size[ own ] - 1 ), b = INFINITY;
+			for( int c = 0; c < k; c++ ) if( c != own && size[ c ] > 0 ) b = min( b, distance[ c ] / size[ c ] );
+
+			double width = max( a, b );
+			if( width > 0.0 ) total += ( b - a ) / width;
+
+		}
+
+		score[ s ] = total / ndata;
+
+	};
+
+	if( pool != nullptr ) pool->parallel_for( n, solution );
+	else for( int s = 0; s < n; s++ ) solution( s, 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Score the given solutions and write the recommendation file: one line per solution, best first
+// (position, solution number as in <prefix>_solution_<i>.txt, k, variance, connectivity, knee, silhouette[, ARI])
+void ModelSelection::write( const vector< int32_t > & labels, const vector< double > & variance, const vector< double > & connectivity, 
+							const vector< int > & clusters, const vector< double > & ari, string prefix, ThreadPoolPtr pool ){
+
+	const int n = int( variance.size() );
+	if( n == 0 ) return;
+
+	vector< double > knee_score, silhouette_score;
+	knee( variance, connectivity, knee_score );
+	silhouette( labels, n, silhouette_score, pool );
+
+	// Position of each solution in both rankings (best first)
+	vector< int > order( n ), points( n, 0 );
+
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(), [ & ]( int a, int b ){ return knee_score[ a ] > knee_score[ b ]; } );
+	for( int p = 0; p < n; p++ ) points[ order[ p ] ] += p;
+
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(), [ & ]( int a, int b ){ return silhouette_score[ a ] > silhouette_score[ b ]; } );
+	for( int p = 0; p < n; p++ ) points[ order[ p ] ] += p;
+
+	// Recommendation: sum of positions, ties broken by silhouette
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(), [ & ]( int a, int b ){ 
+
+		return ( points[ a ] != points[ b ] ) ? points[ a ] < points[ b ] : silhouette_score[ a ] > silhouette_score[ b ]; 
+
+	});
+
+	string filename = prefix + "_model_selection.txt";
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tWriting file: " + filename << endl;
+	#endif
+
+	ofstream file( filename );
+
+	for( int p = 0; p < n; p++ ){
+
+		int s = order[ p ];
+		file << p+1 << "\t" << s+1 << "\t" << clusters[ s ] << "\t" << variance[ s ] << "\t" << connectivity[ s ] << "\t" << knee_score[ s ] << "\t" << silhouette_score[ s ];
+		if( PROBLEM->labels_provided() ) file << "\t" << ari[ s ];
+		file << "\n";
+
+	}
+
+	file.close();
+
+}
+////////////////////////////////////////////////////////////////////////////////
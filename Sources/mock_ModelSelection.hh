@@ -0,0 +1,73 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_MODELSELECTION_HH__
+#define __MOCK_MODELSELECTION_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_ModelSelection.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_ThreadPool.hh"
+
+/******************
+Class definition
+******************/
+
+// Model selection over a set of (nondominated) clusterings (--selection)
+// Each solution is scored by
+// 	knee:		distance below the line joining the extremes of the front (normalised objectives)
+// 	silhouette:	average silhouette width of the data elements (pre-computed distance matrix)
+// and the recommendation file <prefix>_model_selection.txt lists the solutions by the sum of 
+// their positions in both rankings (best first).
+// Silhouettes avoid O(N^2) work per solution: all solutions are unions of the components of their 
+// common refinement (elements with the same labels in every solution), so the distance sums of each 
+// element to each component are computed once, and the sums to a cluster are obtained by adding 
+// those of its components. If there are too many components, sums are computed directly
+class ModelSelection{
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		static void knee( const vector< double > & variance, const vector< double > & connectivity, vector< double > & score );
+		static void silhouette( const vector< int32_t > & labels, const int n, vector< double > & score, ThreadPoolPtr pool );
+		static void components( const vector< int32_t > & labels, const int n, vector< int > & component, int & count );
+
+	public:
+
+		// Model selection requested? (--selection)
+		static bool enabled();
+
+		// Score the given solutions (labels: one row of ndata labels per solution) and write the recommendation file
+		static void write( const vector< int32_t > & labels, const vector< double > & variance, const vector< double > & connectivity, 
+							const vector< int > & clusters, const vector< double > & ari, string prefix, ThreadPoolPtr pool = nullptr );
+
+};
+
+#endif
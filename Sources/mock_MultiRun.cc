@@ -0,0 +1,350 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_MultiRun.hh"
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+MultiRun::MultiRun() : 
+
+	Algorithm( "runs" )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+MultiRun::~MultiRun(){}
+////////////////////////////////////////////////////////////////////////////////
+// Multi-run mode requested? (--runs, --seeds)
+bool MultiRun::enabled(){
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--runs" || input_parameters[ i ][ 0 ] == "--seeds" ) return true;
+
+	}
+
+	return false;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void MultiRun::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_jobs = 0;
+	_runs_filename = "";
+	_seeds = "";
+	_out_filename = "";
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--runs") ){
+
+			// File of run configurations
+			_runs_filename = value;
+
+		}else if( (option == "--seeds") ){
+
+			// Seeds of each configuration
+			_seeds = value;
+
+		}else if( (option == "--jobs") ){
+
+			// Number of runs at a time
+			_jobs = stoi( value );
+
+		}else if( (option == "--output") ){
+
+			// Output filename
+			_out_filename = value;
+
+		}
+
+	}
+
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configures search algorithm: list of runs
+void MultiRun::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _jobs <= 0 ) _jobs = ThreadPool::default_threads();
+	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
+
+	vector< vector< std::pair< string, string > > > configurations;
+	read_configurations( configurations );
+
+	vector< string > seeds;
+	parse_seeds( seeds );
+
+	// Settings common to all runs: command-line options (runs are single-threaded by default)
+	vector< std::pair< string, string > > common = { { "--threads", "1" } };
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		string option = input_parameters[ i ][ 0 ];
+		if( option == "--runs" || option == "--seeds" || option == "--jobs" || option == "--output" ) continue;
+
+		common.push_back( { option, input_parameters[ i ][ 1 ] } );
+
+	}
+	common.push_back( { "--seed", to_string( Context::current()->seed ) } );
+	common.push_back( { "--lparameter", to_string( mock_L ) } );
+	common.push_back( { "--kmax", to_string( mock_Kmax ) } );
+	common.push_back( { "--initialsize", to_string( TOTAL_INITIAL_SOLUTIONS ) } );
+
+	// Runs: each configuration with each seed (options given later prevail)
+	int L = mock_L;
+
+	for( int c = 0; c < int( configurations.size() ); c++ ){
+
+		for( int s = 0; s < int( seeds.size() ); s++ ){
+
+			vector< std::pair< string, string > > run = common;
+			run.push_back( { "--output", _out_filename + "_run" + to_string( _runs.size() + 1 ) } );
+
+			string description;
+			for( int i = 0; i < int( configurations[ c ].size() ); i++ ){
+
+				run.push_back( configurations[ c ][ i ] );
+				description += string( description.empty() ? "" : " " ) + configurations[ c ][ i ].first + " " + configurations[ c ][ i ].second;
+
+				if( configurations[ c ][ i ].first == "--lparameter" ) L = max( L, stoi( configurations[ c ][ i ].second ) );
+
+			}
+
+			if( !seeds[ s ].empty() ){
+
+				run.push_back( { "--seed", seeds[ s ] } );
+				description += string( description.empty() ? "" : " " ) + "--seed " + seeds[ s ];
+
+			}
+
+			_runs.push_back( run );
+			_description.push_back( description );
+
+		}
+
+	}
+
+	// The problem instance (created next) is shared by all runs: 
+	// its neighbour lists, if not complete, must cover the largest L
+	mock_L = L;
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\t\t" << _runs.size() << " runs (" << configurations.size() << " configurations, " << seeds.size() << " seeds)" << endl;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reads the run configurations: options and values of each line of the runs file
+// (blank lines and lines starting with '#' are ignored)
+// A single configuration (command-line options only) if no runs file was given
+void MultiRun::read_configurations( vector< vector< std::pair< string, string > > > & configurations ){
+
+	configurations.clear();
+
+	if( _runs_filename.empty() ){
+
+		configurations.resize( 1 );
+		return;
+
+	}
+
+	ifstream input( _runs_filename );
+	if( !input ){
+		error_message_exit( "Error while trying to open file: " + _runs_filename );
+	}
+
+	// Options that can be set per run (others are shared by all runs)
+	const vector< string > options = { "--population", "--crossover", "--mutation", "--generations", 
+		"--representation", "--delta", "--kmax", "--seed", "--output", "--initialsize", "--lparameter", 
+		"--evaluations", "--steadystate", "--threads", "--checkpoint", "--resume", "--hvepsilon", 
+		"--hvwindow", "--archive", "--archivegrid", "--initialisation", "--minibatch", "--labels", 
+		"--frequency", "--selection" };
+
+	string line;
+	while( std::getline( input, line ) ){
+
+		std::istringstream tokens( line );
+		string option, value;
+
+		if( !( tokens >> option ) || option[ 0 ] == '#' ) continue;
+
+		vector< std::pair< string, string > > configuration;
+		do{
+
+			std::transform( option.begin(), option.end(), option.begin(), ::tolower );
+			if( std::find( options.begin(), options.end(), option ) == options.end() ){
+
+				error_message_exit( "Option cannot be set per run (" + _runs_filename + "): " + option );
+
+			}
+
+			if( !( tokens >> value ) ){
+
+				error_message_exit( "No value was provided for option '" + option + "' (" + _runs_filename + ")" );
+
+			}
+
+			if( option != "--output" ) std::transform( value.begin(), value.end(), value.begin(), ::tolower );
+
+			configuration.push_back( { option, value } );
+
+		}while( tokens >> option );
+
+		configurations.push_back( configuration );
+
+	}
+
+	if( configurations.empty() ) error_message_exit( "No runs were found in file: " + _runs_filename );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Seeds of each configuration: comma-separated seeds or ranges (e.g. 1-30, or 1,5,9)
+// A single empty seed (that of the configuration) if none were given
+void MultiRun::parse_seeds( vector< string > & seeds ){
+
+	seeds.clear();
+
+	if( _seeds.empty() ){
+
+		seeds.push_back( "" );
+		return;
+
+	}
+
+	std::istringstream items( _seeds );
+	string item;
+	while( std::getline( items, item, ',' ) ){
+
+		size_t dash = item.find( '-' );
+		unsigned long first = stoul( item.substr( 0, dash ) );
+		unsigned long last = ( dash == string::npos ) ? first : stoul( item.substr( dash + 1 ) );
+
+		if( first == 0 || last < first ) error_message_exit( "Invalid seeds (--seeds): " + item );
+
+		for( unsigned long s = first; s <= last; s++ ) seeds.push_back( to_string( s ) );
+
+	}
+
+	if( seeds.empty() ) error_message_exit( "Invalid seeds (--seeds): " + _seeds );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine: runs on a pool of --jobs threads, sharing the problem instance
+void MultiRun::run(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Running " << _runs.size() << " runs (" << _jobs << " at a time)" << endl;
+	#endif
+
+	PROFILE_PHASE( "runs" );
+
+	const int n = int( _runs.size() );
+	ClusteringProblemPtr shared = PROBLEM;
+	std::mutex mutex;
+	int finished = 0;
+
+	_time.assign( n, 0.0 );
+
+	ThreadPool pool( min( _jobs, n ) );
+	for( int k = 0; k < n; k++ ){
+
+		pool.submit( [ this, k, n, shared, &mutex, &finished ]( int worker ){
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			{
+
+				Job job( _runs[ k ], shared );
+				job.run();
+				job.write();
+
+			}
+
+			_time[ k ] = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+			#ifdef DISPLAY_PROGRESS_MESSAGES
+				std::lock_guard< std::mutex > lock( mutex );
+				std::ostringstream message;
+				message << "Run " << k+1 << " finished (" << ++finished << "/" << n << ", " << _time[ k ] << " s): " << _description[ k ] << "\n";
+				cout << message.str() << std::flush;
+			#endif
+
+		});
+
+	}
+
+	pool.wait();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reports results: list of runs (run, wall-clock time, options and seed), one per line
+void MultiRun::generate_output( int g ){
+
+	string filename = _out_filename + "_runs.txt";
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Generating output files" << endl;
+		cout << "\tWriting file: " + filename << endl;
+	#endif
+
+	ofstream file( filename );
+	for( int k = 0; k < int( _runs.size() ); k++ ){
+
+		file << ( k + 1 ) << "\t" << _time[ k ] << "\t" << _description[ k ] << "\n";
+
+	}
+	file.close();
+
+	// Run report (loading and pre-computations shared by the runs)
+	#if PROFILE_LEVEL > 0
+		Profiler::current().write( _out_filename + "_run_report.json" );
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,102 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_MULTIRUN_HH__
+#define __MOCK_MULTIRUN_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_MultiRun.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Algorithm.hh"
+#include "mock_Job.hh"
+#include "mock_ThreadPool.hh"
+
+/******************
+Class definition
+******************/
+
+// Multi-run mode: a list of runs (configurations given by --runs, each with the seeds given 
+// by --seeds) on the same data set, --jobs of them at a time
+// The data are loaded and pre-computed once (the problem instance of the process); each run 
+// is a Job with its own random numbers generator, MST orientation, relevant edges, 
+// pre-computed cluster assignment and output files (<output>_run<k>_*)
+class MultiRun : public Algorithm {
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		vector< vector< std::pair< string, string > > > _runs;	// Parameters of each run
+
+		vector< string > _description;		// Options and seed of each run, as given
+
+		vector< double > _time;				// Wall-clock time of each run (seconds)
+
+		int _jobs;							// Number of runs at a time (0: all cores)
+
+		string _runs_filename;				// File of run configurations (one per line)
+
+		string _seeds;						// Seeds of each configuration (e.g. 1-30, or 1,5,9)
+
+		string _out_filename;				// Name of output file(s)
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+		// Configurations (options of each line of the runs file) and seeds
+		void read_configurations( vector< vector< std::pair< string, string > > > & configurations );
+		void parse_seeds( vector< string > & seeds );
+
+	public:
+
+		// Constructor / destructor
+		// NOTE: to be created before the problem instance (neighbour lists must cover the
+		// largest L of the runs)
+		MultiRun();
+		virtual ~MultiRun();
+
+		// Multi-run mode requested? (--runs, --seeds)
+		static bool enabled();
+
+		// Main execution routine
+		virtual void run();
+
+		// Output generation (list of runs; output files of each run are written by the run)
+		virtual void generate_output( int g = -1 );
+
+};
+
+#endif
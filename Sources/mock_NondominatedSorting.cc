@@ -0,0 +1,410 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_NondominatedSorting.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+NondominatedSorting::NondominatedSorting( int max_solutions ) : 
+
+	_max_solutions( max_solutions ),
+	_num_fronts( 0 )
+
+{
+
+	// Allocate memory
+	_sorted = static_cast< ObjectiveTuple * >( allocate_tracked( _max_solutions * sizeof( ObjectiveTuple ), "nondominated_sorting" ) );
+	_crowded = static_cast< CrowdingTuple * >( allocate_tracked( _max_solutions * sizeof( CrowdingTuple ), "nondominated_sorting" ) );
+	_tail = static_cast< ObjectiveTuple * >( allocate_tracked( _max_solutions * sizeof( ObjectiveTuple ), "nondominated_sorting" ) );
+	_front_of = allocate_VectorInt( _max_solutions, "nondominated_sorting" );
+	_members = allocate_VectorInt( _max_solutions, "nondominated_sorting" );
+	_front_start = allocate_VectorInt( _max_solutions + 1, "nondominated_sorting" );
+	_front_start[ 0 ] = 0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+NondominatedSorting::~NondominatedSorting(){
+
+	// Deallocate memory
+	deallocate_tracked( _sorted );
+	deallocate_tracked( _crowded );
+	deallocate_tracked( _tail );
+	deallocate_VectorInt( _front_of );
+	deallocate_VectorInt( _members );
+	deallocate_VectorInt( _front_start );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Nondominated Sorting procedure (two objectives)
+void NondominatedSorting::sort( PopulationPtr pop ){
+
+	int i, f, size = pop->size();
+
+	if( size > _max_solutions ) error_message_exit( "NondominatedSorting: population exceeds the maximum number of solutions!" );
+
+	// Sort solutions in ascending order of the first objective (ties by second objective)
+	for( i = 0; i < size; i++ ){
+
+		_sorted[ i ].f0 = (*pop)[ i ]->objective( 0 );
+		_sorted[ i ].f1 = (*pop)[ i ]->objective( 1 );
+		_sorted[ i ].idx = i;
+
+	}
+
+	std::sort( _sorted, _sorted + size, []( const ObjectiveTuple & a, const ObjectiveTuple & b ){
+
+		if( a.f0 != b.f0 ) return a.f0 < b.f0;
+		if( a.f1 != b.f1 ) return a.f1 < b.f1;
+		return a.idx < b.idx;
+
+	});
+
+	// Sweep: each solution can only be dominated by solutions preceding it. The last solution 
+	// added to each front has the lowest second objective value of that front, and if the k-th 
+	// front dominates a solution so do all fronts before it; thus, binary search the first 
+	// front whose last member does not dominate the current solution
+	_num_fronts = 0;
+	for( i = 0; i < size; i++ ){
+
+		int low = 0, high = _num_fronts;
+
+		while( low < high ){
+
+			int mid = ( low + high ) / 2;
+			if( dominates( _tail[ mid ], _sorted[ i ] ) ) low = mid + 1;
+			else high = mid;
+
+		}
+
+		_front_of[ i ] = low;
+		_tail[ low ] = _sorted[ i ];
+		if( low == _num_fronts ) _num_fronts++;
+
+	}
+
+	// Group solutions by front, keeping the sorted order within each front
+	for( f = 0; f <= _num_fronts; f++ ) _front_start[ f ] = 0;
+	for( i = 0; i < size; i++ ) _front_start[ _front_of[ i ] + 1 ]++;
+	for( f = 0; f < _num_fronts; f++ ) _front_start[ f+1 ] += _front_start[ f ];
+
+	for( i = 0; i < size; i++ ){
+
+		f = _front_of[ i ];
+		_members[ _front_start[ f ]++ ] = _sorted[ i ].idx;
+		(*pop)[ _sorted[ i ].idx ]->rank() = f + 1;
+
+	}
+
+	// Restore front starting positions
+	for( f = _num_fronts; f > 0; f-- ) _front_start[ f ] = _front_start[ f-1 ];
+	_front_start[ 0 ] = 0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Compute the crowding distance for solutions in each front
+void NondominatedSorting::crowding_distance_fronts( PopulationPtr pop ){
+	
+	for( int f = 0; f < _num_fronts; f++ ){ 		
+
+		// Compute crowding distance of the f-th front
+		crowding_distance( pop, f );	
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Compute the crowding distance of the solutions in the f-th front
+// Members of a front are stored in ascending order of the first objective, which (for two 
+// objectives) is also the descending order of the second one; no further sorting is needed
+void NondominatedSorting::crowding_distance( PopulationPtr pop, const int f ){
+
+	VectorIntPtr member = front( f );
+	int n = front_size( f );
+
+	// Initialise
+	for( int i = 0; i < n; i++ ) (*pop)[ member[ i ] ]->crowding_distance() = 0.0;
+
+	// First objective (ascending order: first to last member)
+	double first = (*pop)[ member[ 0 ] ]->objective( 0 ), last = (*pop)[ member[ n-1 ] ]->objective( 0 );
+
+	if( first != last ){
+
+		// Assign INF to extreme solution (best value of this objective)
+		(*pop)[ member[ 0 ] ]->crowding_distance() = INF;
+
+		// Add (normalised) cuboid distance for all other solutions
+		for( int i = 1; i < n-1; i++ ){
+
+			SolutionPtr sol = (*pop)[ member[ i ] ];
+			if( sol->crowding_distance() != INF ){
+
+				sol->crowding_distance() += ( (*pop)[ member[ i+1 ] ]->objective( 0 ) - (*pop)[ member[ i-1 ] ]->objective( 0 ) ) / ( last - first );
+
+			}
+
+		}
+
+	}
+
+	// Second objective (ascending order: last to first member)
+	first = (*pop)[ member[ n-1 ] ]->objective( 1 ), last = (*pop)[ member[ 0 ] ]->objective( 1 );
+
+	if( first != last ){
+
+		// Assign INF to extreme solution (best value of this objective)
+		(*pop)[ member[ n-1 ] ]->crowding_distance() = INF;
+
+		// Add (normalised) cuboid distance for all other solutions
+		for( int i = n-2; i > 0; i-- ){
+
+			SolutionPtr sol = (*pop)[ member[ i ] ];
+			if( sol->crowding_distance() != INF ){
+
+				sol->crowding_distance() += ( (*pop)[ member[ i-1 ] ]->objective( 1 ) - (*pop)[ member[ i+1 ] ]->objective( 1 ) ) / ( last - first );
+
+			}
+
+		}
+
+	}
+
+	// NOTE: Original NSGA-II code implements an additional step where the obtained crowding distance
+	// values are divided by the number of objectives. However, this does not change rank ordering of 
+	// solutions, and therefore is not here implemented for the sake of efficiency.
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reorders the members of the f-th front in descending order of crowding distance
+// (crowding distance is to be maximised); ties keep ascending order of first objective
+void NondominatedSorting::sort_by_crowding( PopulationPtr pop, const int f ){
+
+	VectorIntPtr member = front( f );
+	int n = front_size( f );
+
+	for( int i = 0; i < n; i++ ){
+
+		_crowded[ i ].cwd = (*pop)[ member[ i ] ]->crowding_distance();
+		_crowded[ i ].idx = member[ i ];
+
+	}
+
+	std::stable_sort( _crowded, _crowded + n, []( const CrowdingTuple & a, const CrowdingTuple & b ){
+
+		return a.cwd > b.cwd;
+
+	});
+
+	for( int i = 0; i < n; i++ ) member[ i ] = _crowded[ i ].idx;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Rank the members of the given population from scratch
+void IncrementalNondominatedSorting::build( PopulationPtr pop ){
+
+	_fronts.clear();
+
+	for( int i = 0; i < pop->size(); i++ ){
+
+		// Binary search the first front not dominating the solution
+		SolutionPtr sol = (*pop)[ i ];
+		int low = 0, high = num_fronts();
+
+		while( low < high ){
+
+			int mid = ( low + high ) / 2;
+			if( dominated_by_front( sol, mid ) ) low = mid + 1;
+			else high = mid;
+
+		}
+
+		place( sol, low );
+
+	}
+
+	update_fronts( 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Is the given solution dominated by some member of the f-th front?
+// Only the last member whose first objective does not exceed that of the solution needs
+// to be checked (it has the lowest second objective among all candidate dominators)
+bool IncrementalNondominatedSorting::dominated_by_front( SolutionPtr sol, const int f ) const {
+
+	const vector< SolutionPtr > & front = _fronts[ f ];
+	double f0 = sol->objective( 0 ), f1 = sol->objective( 1 );
+
+	auto it = std::upper_bound( front.begin(), front.end(), f0, []( const double value, const SolutionPtr m ){
+
+		return value < m->objective( 0 );
+
+	});
+
+	if( it == front.begin() ) return false;
+
+	SolutionPtr m = *( it - 1 );
+	return ( m->objective( 1 ) < f1 ) || ( m->objective( 1 ) == f1 && m->objective( 0 ) < f0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Places the solution in the f-th front (assumed not to dominate it) and cascades 
+// the members it dominates to the next front
+void IncrementalNondominatedSorting::place( SolutionPtr sol, const int f ){
+
+	if( f == num_fronts() ) _fronts.resize( f+1 );
+
+	vector< SolutionPtr > & front = _fronts[ f ];
+	double f0 = sol->objective( 0 ), f1 = sol->objective( 1 );
+
+	// Insertion point (ascending order of first objective, ties by second objective)
+	auto pos = std::lower_bound( front.begin(), front.end(), sol, []( const SolutionPtr a, const SolutionPtr b ){
+
+		if( a->objective( 0 ) != b->objective( 0 ) ) return a->objective( 0 ) < b->objective( 0 );
+		return a->objective( 1 ) < b->objective( 1 );
+
+	});
+
+	// Members following the insertion point have a larger or equal first objective value; 
+	// skip exact duplicates, the dominated ones are then contiguous
+	auto first = pos;
+	while( first != front.end() && (*first)->objective( 0 ) == f0 && (*first)->objective( 1 ) == f1 ) first++;
+
+	auto last = first;
+	while( last != front.end() && (*last)->objective( 1 ) >= f1 ) last++;
+
+	vector< SolutionPtr > dominated( first, last );
+	front.erase( first, last );
+	front.insert( pos, sol );
+
+	// Dominated members are nondominated by (and do not dominate) the next front
+	for( int i = 0; i < int( dominated.size() ); i++ ) place( dominated[ i ], f+1 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Updates rank and crowding distance of the members of fronts first, first+1, ...
+void IncrementalNondominatedSorting::update_fronts( const int first ){
+
+	for( int f = first; f < num_fronts(); f++ ){
+
+		for( int i = 0; i < front_size( f ); i++ ) _fronts[ f ][ i ]->rank() = f + 1;
+
+		crowding_distance( _fronts[ f ].data(), front_size( f ) );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Insert a solution: binary search its front, cascade dominated members
+void IncrementalNondominatedSorting::insert( SolutionPtr sol ){
+
+	int low = 0, high = num_fronts();
+
+	while( low < high ){
+
+		int mid = ( low + high ) / 2;
+		if( dominated_by_front( sol, mid ) ) low = mid + 1;
+		else high = mid;
+
+	}
+
+	place( sol, low );
+
+	// Fronts preceding the insertion point are not affected
+	update_fronts( low );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Remove and return the least crowded member of the last front
+// Ties are resolved as in truncation by crowding: the last of them is removed
+SolutionPtr IncrementalNondominatedSorting::remove_worst(){
+
+	vector< SolutionPtr > & front = _fronts.back();
+
+	int worst = 0;
+	for( int i = 1; i < int( front.size() ); i++ ){
+
+		if( front[ i ]->crowding_distance() <= front[ worst ]->crowding_distance() ) worst = i;
+
+	}
+
+	SolutionPtr sol = front[ worst ];
+	front.erase( front.begin() + worst );
+
+	if( front.empty() ) _fronts.pop_back();
+	else crowding_distance( front.data(), int( front.size() ) );
+
+	return sol;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Crowding distance of a front given in ascending order of the first objective
+// (same computation as NondominatedSorting::crowding_distance)
+void IncrementalNondominatedSorting::crowding_distance( SolutionPtr * member, const int n ){
+
+	if( n == 0 ) return;
+
+	// Initialise
+	for( int i = 0; i < n; i++ ) member[ i ]->crowding_distance() = 0.0;
+
+	// First objective (ascending order: first to last member)
+	double first = member[ 0 ]->objective( 0 ), last = member[ n-1 ]->objective( 0 );
+
+	if( first != last ){
+
+		member[ 0 ]->crowding_distance() = INF;
+
+		for( int i = 1; i < n-1; i++ ){
+
+			if( member[ i ]->crowding_distance() != INF ){
+
+				member[ i ]->crowding_distance() += ( member[ i+1 ]->objective( 0 ) - member[ i-1 ]->objective( 0 ) ) / ( last - first );
+
+			}
+
+		}
+
+	}
+
+	// Second objective (ascending order: last to first member)
+	first = member[ n-1 ]->objective( 1 ), last = member[ 0 ]->objective( 1 );
+
+	if( first != last ){
+
+		member[ n-1 ]->crowding_distance() = INF;
+
+		for( int i = n-2; i > 0; i-- ){
+
+			if( member[ i ]->crowding_distance() != INF ){
+
+				member[ i ]->crowding_distance() += ( member[ i-1 ]->objective( 1 ) - member[ i+1 ]->objective( 1 ) ) / ( last - first );
+
+			}
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,169 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_NONDOMINATEDSORTING_HH__
+#define __MOCK_NONDOMINATEDSORTING_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_NondominatedSorting.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Population.hh"
+
+/******************
+Class definition
+******************/
+
+// Nondominated sorting and crowding distance specialised for two objectives
+// Solutions are sorted by the first objective and assigned to fronts by a single
+// sweep with binary search over the fronts found so far (Jensen / Kung et al.),
+// which requires O(N log N) time and O(N) memory
+class NondominatedSorting{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		// Packed (objective values, index) tuple used for sorting
+		struct ObjectiveTuple{
+
+			double f0, f1;
+			int idx;
+
+		};
+
+		// Packed (crowding distance, index) tuple used for sorting
+		struct CrowdingTuple{
+
+			double cwd;
+			int idx;
+
+		};
+
+		int _max_solutions;				// Maximum number of solutions to be sorted
+
+		ObjectiveTuple *_sorted;		// Solutions in ascending order of the objectives
+
+		CrowdingTuple *_crowded;		// Auxiliary structure to sort fronts by crowding distance
+
+		VectorIntPtr _front_of;			// Front index of each (sorted) solution
+
+		VectorIntPtr _members;			// Members of all fronts, grouped by front and in ascending order of first objective
+
+		VectorIntPtr _front_start;		// Position in _members where each front starts (_num_fronts+1 entries)
+
+		ObjectiveTuple *_tail;			// Last solution assigned to each front during the sweep
+
+		int _num_fronts;				// Number of fronts found
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		bool dominates( const ObjectiveTuple & q, const ObjectiveTuple & p ) const;
+
+	public:
+
+		// Constructor / destructor
+		NondominatedSorting( int max_solutions );
+		~NondominatedSorting();
+
+		// Rank the given population (sets the rank of each solution)
+		void sort( PopulationPtr pop );
+
+		// Access to the fronts found by the last call to sort()
+		int num_fronts(){ return _num_fronts; }
+		int front_size( const int f ){ return _front_start[ f+1 ] - _front_start[ f ]; }
+		VectorIntPtr front( const int f ){ return _members + _front_start[ f ]; }
+
+		// Crowding distance of the members of the f-th front
+		void crowding_distance( PopulationPtr pop, const int f );
+		void crowding_distance_fronts( PopulationPtr pop );
+
+		// Reorders the members of the f-th front in descending order of crowding distance
+		void sort_by_crowding( PopulationPtr pop, const int f );
+
+};
+
+// Nondominated sorting (two objectives) maintained incrementally for steady-state replacement
+// Fronts are kept explicitly, each in ascending order of the first objective. Inserting a solution 
+// binary-searches its front and cascades the members it dominates to the following fronts; the 
+// worst solution (least crowded member of the last front) can then be removed without affecting 
+// the rank of any other solution
+class IncrementalNondominatedSorting{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		vector< vector< SolutionPtr > > _fronts;	// Members of each front, in ascending order of first objective
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		bool dominated_by_front( SolutionPtr sol, const int f ) const;
+		void place( SolutionPtr sol, const int f );
+		void update_fronts( const int first );
+
+	public:
+
+		// Rank the members of the given population from scratch
+		void build( PopulationPtr pop );
+
+		// Insert a solution (ranks and crowding distances are updated)
+		void insert( SolutionPtr sol );
+
+		// Remove and return the least crowded member of the last front
+		SolutionPtr remove_worst();
+
+		// Access to current fronts
+		int num_fronts() const { return int( _fronts.size() ); }
+		int front_size( const int f ) const { return int( _fronts[ f ].size() ); }
+
+		// Crowding distance of a front given in ascending order of the first objective
+		static void crowding_distance( SolutionPtr * member, const int n );
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Does q dominate p? Assumes q precedes p in the sorted order (q.f0 <= p.f0)
+inline bool NondominatedSorting::dominates( const ObjectiveTuple & q, const ObjectiveTuple & p ) const {
+
+	return ( q.f1 < p.f1 ) || ( q.f1 == p.f1 && q.f0 < p.f0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -24,17 +24,43 @@ Last updated: 10 July 2017
 *******************************************************************************/
 
 #include "mock_Nsga2.hh"
+#include "mock_Nsga2Typed.hh"
+#include "mock_IslandModel.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
 Nsga2::Nsga2() : 
 
-	Algorithm( "nsga2" )
+	Algorithm( "nsga2" ),
+	_evaluator( nullptr ),
+	_store( nullptr ),
+	_pool( nullptr ),
+	_archive( nullptr )
 
 {
 
 	initialise();
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Factory: the representation is fixed for the whole run, so the generation loop
+// (variation operators, solution creation) is instantiated for its specific type
+Nsga2 * Nsga2::create(){
+
+	string representation = "locus";
+	for( int i = 0; i < input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--representation" ) representation = input_parameters[ i ][ 1 ];
+
+	}
+
+	if( representation == "locus" ) return new Nsga2Typed< SolutionLocus >();
+	if( representation == "short" ) return new Nsga2Typed< SolutionShort >();
+	if( representation == "split" ) return new Nsga2Typed< SolutionSplit >();
+
+	// Unrecognised representations are reported by configure()
+	return new Nsga2();
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Destructor
@@ -44,12 +70,15 @@ Nsga2::~Nsga2(){
 	delete _population;
 	delete _offspring;
 	delete _auxiliary;
+	delete _store;
 	delete _evaluator;
-	deallocate_MatrixInt( _nds_front, _max_solutions );
-	deallocate_MatrixInt( _nds_s, _max_solutions );
-	deallocate_VectorInt( _nds_n );
-	deallocate_VectorDouble( idx_val_tuples );
+	delete _nds;
+	delete _hypervolume;
+	delete _archive;
+	delete _pool;
+	delete _snapshots;
 	deallocate_VectorInt( parents );
+	deallocate_VectorInt( _mating );
 	
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,7 +98,20 @@ void Nsga2::initialise(){
 	_max_evaluations = 0;
 	_out_filename = "";
 	_frequency = 0;
+	_snapshots = nullptr;
 	_representation = "locus";
+	_steady_state = false;
+	_threads = 0;
+	_checkpoint_frequency = 0;
+	_resume = false;
+	_hv_epsilon = 0.0;
+	_hv_window = 10;
+	_archive_size = 0;
+	_archive_epsilon = 0.0;
+	_initialisation = "priority";
+	_minibatch = 0;
+	_kmeans = nullptr;
+	_converged = false;
 
 	// Load and set input parameters 
 	// (these override default settings if provided)
@@ -120,6 +162,56 @@ void Nsga2::initialise(){
 			// Solutions' encoding
 			_representation = value;
 
+		}else if( (option == "--steadystate") ){
+
+			// Asynchronous steady-state variant
+			_steady_state = ( value == "true" );
+
+		}else if( (option == "--threads") ){
+
+			// Number of threads (0: hardware concurrency)
+			_threads = stoi( value );
+
+		}else if( (option == "--checkpoint") ){
+
+			// How often to write a checkpoint (generations)
+			_checkpoint_frequency = stoi( value );
+
+		}else if( (option == "--resume") ){
+
+			// Resume search from the latest checkpoint
+			_resume = ( value == "true" );
+
+		}else if( (option == "--hvepsilon") ){
+
+			// Early stopping: minimum relative hypervolume gain
+			_hv_epsilon = stod( value );
+
+		}else if( (option == "--hvwindow") ){
+
+			// Early stopping: number of generations considered
+			_hv_window = stoi( value );
+
+		}else if( (option == "--archive") ){
+
+			// Maximum size of the external archive
+			_archive_size = stoi( value );
+
+		}else if( (option == "--archivegrid") ){
+
+			// Relative box size of the external archive's grid
+			_archive_epsilon = stod( value );
+
+		}else if( (option == "--initialisation") ){
+
+			// Initial solutions
+			_initialisation = value;
+
+		}else if( (option == "--minibatch") ){
+
+			// Mini-batch size of k-means
+			_minibatch = stoi( value );
+
 		}
 
 	}	
@@ -155,13 +247,35 @@ void Nsga2::configure(){
 	_auxiliary = PopulationPtr( new Population( _max_solutions ) );	
 
 	// Allocate memory for auxiliary data strucrures, initialise
-	_nds_front = allocate_MatrixInt( _max_solutions, _max_solutions + 1 );
-	for( int i=0; i<_max_solutions; i++ ) _nds_front[ i ][ 0 ] = 0;		
-	_nds_s = allocate_MatrixInt( _max_solutions, _max_solutions + 1 );
-	_nds_n = allocate_VectorInt( _max_solutions );
-	idx_val_tuples = allocate_VectorDouble( 2 * _max_solutions );
-	parents = allocate_VectorInt( _population_size );
+	// Nondominated sorting and crowding are specialised for two objectives
+	if( num_objectives != 2 ) error_message_exit( "Nondominated sorting requires exactly two objectives!" );
+	_nds = NondominatedSortingPtr( new NondominatedSorting( _max_solutions ) );
+	_hypervolume = HypervolumePtr( new Hypervolume() );
+	if( _hv_window < 1 ) error_message_exit( "Hypervolume window needs to be at least one generation! (--hvwindow)" );
+	parents = allocate_VectorInt( _population_size, "population" );
 	for( int i=0; i<_population_size; i++ ) parents[ i ] = i;
+	_mating = allocate_VectorInt( 2 * _population_size, "population" );
+	_streams.resize( _population_size / 2 );
+
+	// External archive
+	if( _archive_size < 0 || _archive_epsilon < 0.0 ) error_message_exit( "Archive size and grid need to be non-negative! (--archive, --archivegrid)" );
+	if( _archive_size > 0 ) _archive = ParetoArchivePtr( new ParetoArchive( _archive_size, _representation, _archive_epsilon ) );
+
+	// Checkpoints (generational variant only; the state of a run must be reproducible)
+	if( _checkpoint_frequency > 0 || _resume ){
+
+		if( _steady_state ) error_message_exit( "Checkpoints are not supported by the steady-state variant (--checkpoint, --resume)" );
+		if( Context::current()->seed == 0 ) error_message_exit( "Checkpoints require an explicit seed (--seed)" );
+
+	}
+
+	// Initial solutions
+	if( _initialisation != "priority" && _initialisation != "kmeans" && _initialisation != "kmedoids" && _initialisation != "hybrid" )
+		error_message_exit( "Unrecognised initialisation (--initialisation): " + _initialisation );
+	if( _minibatch < 0 ) error_message_exit( "Mini-batch size needs to be non-negative! (--minibatch)" );
+
+	// Output settings (verified before the search)
+	OutputWriter::labels_format();
 
 	// Set stopping condition
 	_max_evaluations = ( _population_size * (_max_generations-1) + TOTAL_INITIAL_SOLUTIONS ); // Since TOTAL_INITIAL_SOLUTIONS >= _population_size
@@ -170,18 +284,21 @@ void Nsga2::configure(){
 	if( _representation == "locus" ){
 
 		initialisation = &Nsga2::hybrid_initialisation; 
+		clustered_solution = ( _initialisation == "kmedoids" ) ? &Nsga2::create_kmedoids_solution : &Nsga2::create_kmeans_solution;
 		crossover_operator = &BinaryOperator::uniform_crossover;
 		mutation_operator = &UnaryOperator::neighbourhood_biased_mutation;
 
 	}else if( _representation == "short" ){
 
 		initialisation = &Nsga2::hybrid_initialisation_short;		
+		clustered_solution = ( _initialisation == "kmedoids" ) ? &Nsga2::create_kmedoids_solution_short : &Nsga2::create_kmeans_solution_short;
 		crossover_operator = &BinaryOperator::uniform_crossover;
 		mutation_operator = &UnaryOperator::neighbourhood_biased_mutation_short;
 
 	}else if( _representation == "split" ){
 
 		initialisation = &Nsga2::hybrid_initialisation_split;		
+		clustered_solution = ( _initialisation == "kmedoids" ) ? &Nsga2::create_kmedoids_solution_split : &Nsga2::create_kmeans_solution_split;
 		crossover_operator = &BinaryOperator::uniform_crossover;
 		mutation_operator = &UnaryOperator::neighbourhood_biased_mutation_split;
 
@@ -200,53 +317,282 @@ void Nsga2::run(){
 		cout << "Running " + _algorithm_name << endl;
 	#endif	
 
+	// Termination requests (SIGTERM, SIGINT) are handled by writing a checkpoint
+	if( _checkpoint_frequency > 0 ) Checkpoint::install_signal_handlers();
+
+	// Initialisation, initial population (or latest checkpoint)
+	start();
+
+	// Report initial population (background writer)
+	if( _frequency > 0 ){
+
+		_snapshots = SnapshotWriterPtr( new SnapshotWriter( [ this ]{ return create_solution(); } ) );
+		snapshot();
+
+	}
+
+	// Asynchronous steady-state variant
+	if( _steady_state ){
+
+		run_steady_state();
+		finish_snapshots();
+		return;
+
+	}
+	
+	// Main loop
+	// Stop condition is based on number of evaluations
+	while( !finished() ){
+
+		step();
+
+		// Report rank-1 front every _frequency generations
+		if( _frequency > 0 && _generation % _frequency == 0 ) snapshot();
+
+		// Checkpoint every _checkpoint_frequency generations and upon termination request
+		if( _checkpoint_frequency > 0 ){
+
+			if( _generation % _checkpoint_frequency == 0 || Checkpoint::interrupted() ) write_checkpoint();
+
+			if( Checkpoint::interrupted() ){
+
+				error_message_exit( "Search interrupted (signal " + to_string( Checkpoint::interrupted() ) + ") at generation " + to_string( _generation ) + ", resume with --resume true" );
+
+			}
+
+		}
+
+	}
+
+	// Intermediate results still being written
+	finish_snapshots();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Generates, evaluates and ranks the initial population (first generation)
+void Nsga2::start(){
+
+	// Offspring generation threads (generational variant)
+	int threads = ( _threads > 0 ) ? _threads : ThreadPool::default_threads();
+	if( !_steady_state && threads > 1 && _pool == nullptr ) _pool = ThreadPoolPtr( new ThreadPool( threads ) );
+
+	// Continue from the latest checkpoint?
+	if( _resume ){
+
+		read_checkpoint();
+		adopt_population_store();
+		return;
+
+	}
+
 	// Generate initial set of solutions (specialised initialisation based on MST, interestingness, and kmeans)	
-	(this->*initialisation)( true ); 
+	{
+		PROFILE_PHASE( "initialisation" );
+		(this->*initialisation)( true ); 
+	}
 
 	// Instantiate Evaluator object
-	// This depends on the particular encoding scheme used
 	// NOTE: Instantiation of EvaluatorDelta must be after initialisation
 	// since it requires first identifying the relevant and fixed edges
-	if( _representation == "locus" ){
-
-		_evaluator = EvaluatorPtr( new EvaluatorFull() ); 
-
-	}else{
-	 	
-	 	_evaluator = EvaluatorPtr( new EvaluatorDelta() ); 
-
-	} 
+	_evaluator = create_evaluator();
 
 	// Construct initial parent population based on the solutions obtained during initialisation
 	// Evaluate and rank population
-	generate_evaluate_initial_population();
+	{
+		PROFILE_PHASE( "initial_evaluation" );
+		generate_evaluate_initial_population();
+	}
+	adopt_population_store();
 	_generation = 1;
 
+	// Hypervolume reference point is fixed based on the initial population
+	_hypervolume->set_reference( _population );
+	track_hypervolume( _evaluator->total_evaluations() );
+
 	#ifdef DISPLAY_PROGRESS_MESSAGES
 		cout << "\tGeneration: " << _generation << " ( " << _evaluator->total_evaluations() << " evaluations )" << endl;
 	#endif
 
-	// Report initial population
-	if( _frequency > 0 ) generate_output( _generation );	
-	
-	// Main loop
-	// for( _generation = 2; _generation <= _max_generations; _generation++ ){ // Stop condition is based on number of generations
-	for( _generation = 2; _evaluator->total_evaluations() < _max_evaluations; _generation++ ){ // Stop condition is based on number of evaluations
-		
-		// Selection (binary tournament) and variation (crossover, mutation)
+}
+////////////////////////////////////////////////////////////////////////////////
+// Performs one generation of the (generational) algorithm
+void Nsga2::step(){
+
+	_generation++;
+
+	// Selection (binary tournament) and variation (crossover, mutation)
+	{
+		PROFILE_PHASE( "variation" );
 		selection_variation();
+	}
 
-		// Evaluate produced offspring
+	// Evaluate produced offspring
+	{
+		PROFILE_PHASE( "evaluation" );
 		_evaluator->evaluate( _offspring );
+	}
+	if( _archive != nullptr ){
+
+		PROFILE_PHASE( "archive" );
+		_archive->insert( _offspring );
 
-		// Replacement (survival selection)
+	}
+
+	// Replacement (survival selection)
+	{
+		PROFILE_PHASE( "replacement" );
 		replacement();		
+	}
 
-		#ifdef DISPLAY_PROGRESS_MESSAGES
-			cout << "\tGeneration: " << _generation << " ( " << _evaluator->total_evaluations() << " evaluations )" << endl;
-		#endif	
+	// Convergence tracking
+	track_hypervolume( _evaluator->total_evaluations() );
 
-	}	
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tGeneration: " << _generation << " ( " << _evaluator->total_evaluations() << " evaluations )" << endl;
+	#endif	
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Stopping condition (number of evaluations, or convergence if early stopping is enabled)
+// Based on number of generations: _generation >= _max_generations
+bool Nsga2::finished(){
+
+	return _converged || _evaluator->total_evaluations() >= _max_evaluations;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Length of the genotype for the chosen representation
+// (for reduced-length representations, only valid once relevant edges were determined)
+int Nsga2::encoding_length(){
+
+	if( _representation == "locus" ) return SolutionLocus::static_encoding_length();
+	if( _representation == "short" ) return SolutionShort::static_encoding_length();
+	return SolutionSplit::static_encoding_length();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// New (uninitialised) solution object of the chosen representation
+SolutionPtr Nsga2::create_solution(){
+
+	if( _representation == "locus" ) return SolutionPtr( new SolutionLocus( false ) );
+	if( _representation == "short" ) return SolutionPtr( new SolutionShort( false ) );
+	return SolutionPtr( new SolutionSplit( false ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Sets up the (read-only) problem information required by the chosen representation
+// Only needs to be called explicitly before several Nsga2 instances run concurrently
+void Nsga2::prepare_problem(){
+
+	if( _representation != "locus" ){
+
+		PROBLEM->determine_relevant_edges();
+		PROBLEM->precomputed_assignment();
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Sends copies of (at most) n randomly chosen rank-1 individuals through the given buffer
+// Migrants which do not fit in the buffer are discarded
+void Nsga2::emigrate( MigrantBufferPtr ring, int n ){
+
+	vector< int > candidates;
+	for( int i = 0; i < _population_size; i++ ){
+
+		if( (*_population)[ i ]->rank() == 1 ) candidates.push_back( i );
+
+	}
+
+	n = min( n, int( candidates.size() ) );
+
+	// Partial Fisher-Yates shuffle
+	for( int i = 0; i < n; i++ ){
+
+		int r = random_int( i, int( candidates.size() ) - 1 );
+		std::swap( candidates[ i ], candidates[ r ] );
+
+		if( !ring->push( (*_population)[ candidates[ i ] ] ) ) break;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Replaces the worst individuals (last fronts, most crowded first) by the migrants
+// available in the given buffer, and ranks the population again
+// At most half of the population is replaced
+void Nsga2::immigrate( MigrantBufferPtr ring ){
+
+	vector< int > order( _population_size );
+	for( int i = 0; i < _population_size; i++ ) order[ i ] = i;
+
+	std::sort( order.begin(), order.end(), [ this ]( const int a, const int b ){
+
+		SolutionPtr sa = (*_population)[ a ], sb = (*_population)[ b ];
+		if( sa->rank() != sb->rank() ) return sa->rank() > sb->rank();
+		if( sa->crowding_distance() != sb->crowding_distance() ) return sa->crowding_distance() < sb->crowding_distance();
+		return a < b;
+
+	});
+
+	int received = 0;
+	while( received < _population_size / 2 && ring->pop( (*_population)[ order[ received ] ] ) ) received++;
+
+	if( received > 0 ){
+
+		_nds->sort( _population );
+		_nds->crowding_distance_fronts( _population );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Is the next initial solution a k-means/k-medoids solution (rather than a priority solution)?
+// Hybrid initialisation: k-means or priority solutions with equal probability
+bool Nsga2::clustered_initial_solution(){
+
+	if( _initialisation == "priority" ) return false;
+	if( _initialisation == "hybrid" ) return ( random_real( 0.0, 1.0 ) < 0.5 );
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates the k-means/k-medoids solutions of the given slots (position in the repository, k)
+// Each slot uses its own random numbers stream (jump-ahead), so solutions do not depend on the number
+// of threads. Slots run in parallel if there are at least as many as threads; otherwise each 
+// clustering spreads its assignment steps over the threads
+void Nsga2::create_clustered_solutions( vector< std::pair< int, int > > & pending ){
+
+	if( pending.empty() ) return;
+
+	_kmeans = KMeansPtr( new KMeans( _minibatch ) );
+
+	vector< Random > streams( pending.size() );
+	Random stream( (*rnd)() );
+	for( size_t p = 0; p < pending.size(); p++ ){
+
+		streams[ p ] = stream;
+		stream.jump();
+
+	}
+
+	const bool across_k = ( _pool != nullptr && int( pending.size() ) >= _pool->size() );
+	ThreadPoolPtr data_pool = across_k ? nullptr : _pool;
+
+	auto task = [ this, &pending, &streams, data_pool ]( int p, int worker ){
+
+		RandomPtr main = rnd;
+		rnd = &streams[ p ];
+		_auxiliary->set( pending[ p ].first, (this->*clustered_solution)( pending[ p ].second, data_pool ) );
+		rnd = main;
+
+	};
+
+	if( across_k ) _pool->parallel_for( int( pending.size() ), task );
+	else for( int p = 0; p < int( pending.size() ); p++ ) task( p, 0 );
+
+	delete _kmeans;
+	_kmeans = nullptr;
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -270,6 +616,51 @@ SolutionPtr Nsga2::create_priority_solution( int n ){
 
 	return sol;
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution encoding the given clustering (label of each data point)
+// MST links within a cluster are kept; the remaining points link to their nearest neighbour in 
+// the same cluster (or, if none among the candidate neighbours, to a random neighbour)
+SolutionPtr Nsga2::create_labels_solution( const vector< int > & labels ){
+
+	SolutionPtr sol = SolutionPtr( new SolutionLocus( false ) );
+
+	for( int i = 0; i < PROBLEM->ndata(); i++ ){
+
+		int link = PROBLEM->mst_edge( i );
+
+		if( labels[ link ] != labels[ i ] ){
+
+			int j = 0;
+			while( j <= mock_L && labels[ PROBLEM->neighbour( i, j ) ] != labels[ i ] ) j++;
+			link = ( j <= mock_L ) ? PROBLEM->neighbour( i, j ) : SolutionLocus::static_random_encoding( i, link );
+
+		}
+
+		(*sol)[ i ] = link;
+
+	}
+
+	return sol;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-means clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmeans_solution( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmeans( n, labels, pool );
+	return create_labels_solution( labels );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-medoids clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmedoids_solution( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmedoids( n, labels, pool );
+	return create_labels_solution( labels );
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 void Nsga2::hybrid_initialisation( bool instantiate_offspring ){
@@ -289,6 +680,7 @@ void Nsga2::hybrid_initialisation( bool instantiate_offspring ){
 	// List of all possible k values
 	VectorIntPtr possible_k = allocate_VectorInt( mock_Kmax-1 );
 	for( int k = 2; k <= mock_Kmax; k++ ) possible_k[ k-2 ] = k;
+	vector< std::pair< int, int > > pending;	// Slots of clustered solutions (position, k)
 
 	do{
 
@@ -300,8 +692,17 @@ void Nsga2::hybrid_initialisation( bool instantiate_offspring ){
 			// Actual value of k
 			int target_k = possible_k[ k-2 ];			
 
-			// Create priority solution
-			sol = create_priority_solution( target_k-1 );
+			// Create priority solution, or leave a slot for a k-means/k-medoids solution (created below)
+			if( clustered_initial_solution() ){
+
+				pending.push_back( std::make_pair( _auxiliary->size(), target_k ) );
+				sol = nullptr;
+
+			}else{
+
+				sol = create_priority_solution( target_k-1 );
+
+			}
 
 			// Add solution to repository
 			_auxiliary->add( sol );
@@ -310,6 +711,9 @@ void Nsga2::hybrid_initialisation( bool instantiate_offspring ){
 
 	}while( _auxiliary->size() < TOTAL_INITIAL_SOLUTIONS );	
 
+	// k-means/k-medoids solutions
+	create_clustered_solutions( pending );
+
 	// Clean memory
 	deallocate_VectorInt( possible_k );
 
@@ -347,6 +751,52 @@ SolutionPtr Nsga2::create_priority_solution_short( int n ){
 
 	return sol;
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution encoding the given clustering (label of each data point)
+// Relevant MST links within a cluster are kept; the remaining ones are replaced by a link to the 
+// nearest neighbour in the same cluster (or, if none among the candidate neighbours, to a random neighbour)
+SolutionPtr Nsga2::create_labels_solution_short( const vector< int > & labels ){
+
+	SolutionPtr sol = SolutionPtr( new SolutionShort( false ) );
+
+	for( int i = 0, edge; i < SolutionShort::static_encoding_length(); i++ ){
+
+		edge = PROBLEM->relevant_edge( i );
+		int link = PROBLEM->mst_edge( edge );
+
+		if( labels[ link ] != labels[ edge ] ){
+
+			int j = 0;
+			while( j <= mock_L && labels[ PROBLEM->neighbour( edge, j ) ] != labels[ edge ] ) j++;
+			link = ( j <= mock_L ) ? PROBLEM->neighbour( edge, j ) : SolutionShort::static_random_encoding( i, link );
+
+		}
+
+		(*sol)[ i ] = link;
+
+	}
+
+	return sol;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-means clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmeans_solution_short( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmeans( n, labels, pool );
+	return create_labels_solution_short( labels );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-medoids clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmedoids_solution_short( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmedoids( n, labels, pool );
+	return create_labels_solution_short( labels );
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Specialised initialisation of MOCK based on MST and K-means
@@ -371,6 +821,7 @@ void Nsga2::hybrid_initialisation_short( bool instantiate_offspring ){
 	// List of all possible k values
 	VectorIntPtr possible_k = allocate_VectorInt( mock_Kmax-1 );
 	for( int k = 2; k <= mock_Kmax; k++ ) possible_k[ k-2 ] = k;
+	vector< std::pair< int, int > > pending;	// Slots of clustered solutions (position, k)
 
 	do{
 
@@ -382,8 +833,17 @@ void Nsga2::hybrid_initialisation_short( bool instantiate_offspring ){
 			// Actual value of k
 			int target_k = possible_k[ k-2 ];			
 
-			// Create priority solution
-			sol = create_priority_solution_short( target_k-1 );
+			// Create priority solution, or leave a slot for a k-means/k-medoids solution (created below)
+			if( clustered_initial_solution() ){
+
+				pending.push_back( std::make_pair( _auxiliary->size(), target_k ) );
+				sol = nullptr;
+
+			}else{
+
+				sol = create_priority_solution_short( target_k-1 );
+
+			}
 
 			// Add solution to repository
 			_auxiliary->add( sol );
@@ -392,6 +852,9 @@ void Nsga2::hybrid_initialisation_short( bool instantiate_offspring ){
 
 	}while( _auxiliary->size() < TOTAL_INITIAL_SOLUTIONS );	
 
+	// k-means/k-medoids solutions
+	create_clustered_solutions( pending );
+
 	// Clean memory
 	deallocate_VectorInt( possible_k );
 
@@ -426,6 +889,41 @@ SolutionPtr Nsga2::create_priority_solution_split( int n ){
 
 	return sol;
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution encoding the given clustering (label of each data point)
+// Relevant MST links are kept (1) if they join points of the same cluster, removed (0) otherwise
+SolutionPtr Nsga2::create_labels_solution_split( const vector< int > & labels ){
+
+	SolutionPtr sol = SolutionPtr( new SolutionSplit( false ) );
+
+	for( int i = 0, edge; i < SolutionSplit::static_encoding_length(); i++ ){
+
+		edge = PROBLEM->relevant_edge( i );
+		(*sol)[ i ] = ( labels[ edge ] == labels[ PROBLEM->mst_edge( edge ) ] ) ? 1 : 0;
+
+	}
+
+	return sol;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-means clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmeans_solution_split( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmeans( n, labels, pool );
+	return create_labels_solution_split( labels );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates solution from a k-medoids clustering of the data into n clusters
+SolutionPtr Nsga2::create_kmedoids_solution_split( int n, ThreadPoolPtr pool ){
+
+	vector< int > labels;
+	_kmeans->kmedoids( n, labels, pool );
+	return create_labels_solution_split( labels );
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Specialised initialisation of MOCK based on MST and K-means
@@ -450,6 +948,7 @@ void Nsga2::hybrid_initialisation_split( bool instantiate_offspring ){
 	// List of all possible k values
 	VectorIntPtr possible_k = allocate_VectorInt( mock_Kmax-1 );
 	for( int k = 2; k <= mock_Kmax; k++ ) possible_k[ k-2 ] = k;
+	vector< std::pair< int, int > > pending;	// Slots of clustered solutions (position, k)
 
 	do{
 
@@ -461,8 +960,17 @@ void Nsga2::hybrid_initialisation_split( bool instantiate_offspring ){
 			// Actual value of k
 			int target_k = possible_k[ k-2 ];			
 
-			// Create priority solution
-			sol = create_priority_solution_split( target_k-1 );
+			// Create priority solution, or leave a slot for a k-means/k-medoids solution (created below)
+			if( clustered_initial_solution() ){
+
+				pending.push_back( std::make_pair( _auxiliary->size(), target_k ) );
+				sol = nullptr;
+
+			}else{
+
+				sol = create_priority_solution_split( target_k-1 );
+
+			}
 
 			// Add solution to repository
 			_auxiliary->add( sol );
@@ -471,6 +979,9 @@ void Nsga2::hybrid_initialisation_split( bool instantiate_offspring ){
 
 	}while( _auxiliary->size() < TOTAL_INITIAL_SOLUTIONS );	
 
+	// k-means/k-medoids solutions
+	create_clustered_solutions( pending );
+
 	// Clean memory
 	deallocate_VectorInt( possible_k );
 
@@ -499,6 +1010,14 @@ void Nsga2::generate_evaluate_initial_population(){
 		// Evaluate initial solutions
     	_evaluator->evaluate( _auxiliary );
 
+		// External archive (grid defined by the initial solutions)
+		if( _archive != nullptr ){
+
+			_archive->set_grid( _auxiliary );
+			_archive->insert( _auxiliary );
+
+		}
+
 		// Allocate aux memory to store nonselected individuals
 		PopulationPtr toremove = PopulationPtr( new Population( _auxiliary->size() - _population_size ) );	
 
@@ -529,203 +1048,369 @@ void Nsga2::generate_evaluate_initial_population(){
 
 }
 ////////////////////////////////////////////////////////////////////////////////
-// Mating selection, crossover and mutation
-void Nsga2::selection_variation(){	
+// Parent and offspring solutions are moved to a contiguous store (parents first);
+// from now on, they are only overwritten, never reallocated
+void Nsga2::adopt_population_store(){
 
-	// Two repetitions are required in order to produce all offspring
-	for( int rep=0, ctr=0; rep<2; rep++ ){
+	_store = PopulationStorePtr( new PopulationStore( 2 * _population_size, encoding_length() ) );
+	_store->adopt( _population, 0 );
+	_store->adopt( _offspring, _population_size );
 
-		// Generate permutation of the parents
-		shuffle( parents, _population_size );
+}
+////////////////////////////////////////////////////////////////////////////////
+// Instantiates an Evaluator object, which depends on the particular encoding scheme used
+// Several EvaluatorDelta objects share the precomputed cluster assignment of the problem
+EvaluatorPtr Nsga2::create_evaluator( bool batch ){
 
-		// Apply selection, crossover and mutation
-		for( int i=0; i<_population_size; i+=4 ){
+	if( _representation == "locus" ){
 
-			// Decide parents by means of tournament selection
-			SolutionPtr parent1 = binary_tournament(	(*_population)[ parents[ i   ] ]	,
-														(*_population)[ parents[ i+1 ] ] 	);
-			SolutionPtr parent2 = binary_tournament(	(*_population)[ parents[ i+2 ] ]	,
-														(*_population)[ parents[ i+3 ] ] 	);
+		return EvaluatorPtr( new EvaluatorFull() ); 
 
-			// Pointers to children to be created
-			SolutionPtr child1 = (*_offspring)[ ctr++ ];
-			SolutionPtr child2 = (*_offspring)[ ctr++ ];
+	}
 
-			// Apply crossover
-			(*crossover_operator)( parent1, parent2, child1, child2, _crossover_prob );
+	return EvaluatorPtr( new EvaluatorDelta( batch && _representation == "split" ) ); 
 
-			// Apply mutation
-			(*mutation_operator)( child1, _mutation_prob ); 
-			(*mutation_operator)( child2, _mutation_prob ); 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Asynchronous steady-state main loop
+// The main thread breeds offspring (binary tournaments, crossover, mutation) while worker 
+// threads evaluate them; each completed offspring is inserted into the parent population, 
+// ranked incrementally, and the worst individual is discarded. There is no generational
+// barrier, so workers do not idle when evaluation times vary. Exactly _max_evaluations
+// evaluations are performed. With more than one thread, results depend on completion order
+void Nsga2::run_steady_state(){
 
-		}
+	PROFILE_PHASE( "steady_state" );
 
-	}
+	ThreadPool pool( _threads );
 
-}
-////////////////////////////////////////////////////////////////////////////////
-// Binary tournament selection
-SolutionPtr Nsga2::binary_tournament( SolutionPtr p1, SolutionPtr p2 ){
+	// One evaluator per worker
+	vector< EvaluatorPtr > evaluators( pool.size() );
+	for( int w = 0; w < pool.size(); w++ ) evaluators[ w ] = create_evaluator( false );
 
-	// First criterion: dominance
-	int dominance = pareto_dominance( p1->objective(), p2->objective(), num_objectives );
-	if( dominance == 1 ) return p1;
-	if( dominance == 2 ) return p2;
+	// Ranking of the parent population, maintained incrementally
+	IncrementalNondominatedSorting ranking;
+	ranking.build( _population );
 
-	// Second criterion: crowding
-	if( p1->crowding_distance() > p2->crowding_distance() ) return p1;
-	if( p1->crowding_distance() < p2->crowding_distance() ) return p2;
+	// Offspring solutions are used as containers for the individuals being bred and evaluated
+	vector< SolutionPtr > available;
+	for( int i = 0; i < _offspring->size(); i++ ) available.push_back( (*_offspring)[ i ] );
+	_offspring->clear();
 
-	// Otherwise: random decision
-	return ( random_real(0, 1) < 0.5 ) ? p1 : p2;
+	// Offspring in flight (two per worker, bred in pairs)
+	int max_in_flight = min( 2 * pool.size(), _population_size );
+	int in_flight = 0;
 
-}
-////////////////////////////////////////////////////////////////////////////////
-// Nondominated Sorting procedure
-void Nsga2::nondominated_sorting( PopulationPtr pop ){
+	// Evaluated offspring, in completion order
+	std::mutex completed_mutex;
+	std::condition_variable completed_cv;
+	std::deque< SolutionPtr > completed;
 
-	int p, q, i, dominance, size = pop->size();	
-	
-	// Initialise
-	for( p=0; p<size; p++ ){
+	unsigned long issued = _evaluator->total_evaluations();
+	unsigned long evaluations = issued;
 
-		_nds_n[ p ] = 0;		
-		_nds_s[ p ][ 0 ] = 0;
-		_nds_front[ p ][ 0 ] = 0;
+	while( true ){
 
-	}
-	
-	// Compute first front
-	for( p=0; p<size; p++ ){
+		// Breed and submit new offspring
+		while( issued < _max_evaluations && !_converged && in_flight + 2 <= max_in_flight ){
 
-		for( q=0; q<size; q++ ){
-			
-			if( p!=q ){
-				
-				dominance = pareto_dominance( (*pop)[ p ]->objective(), (*pop)[ q ]->objective(), num_objectives );
-				
-				if( dominance == 1 ){ // p dominates q   ->  include q in _nds_s[p]
+			// Decide parents by means of tournament selection
+			SolutionPtr parent1 = binary_tournament(	(*_population)[ random_int( 0, _population_size-1 ) ],
+														(*_population)[ random_int( 0, _population_size-1 ) ] );
+			SolutionPtr parent2 = binary_tournament(	(*_population)[ random_int( 0, _population_size-1 ) ],
+														(*_population)[ random_int( 0, _population_size-1 ) ] );
 
-					_nds_s[ p ][ 0 ]++;
-					_nds_s[ p ][ _nds_s[ p ][ 0 ] ] = q;	
+			SolutionPtr child[ 2 ];
+			child[ 0 ] = available.back(); available.pop_back();
+			child[ 1 ] = available.back(); available.pop_back();
 
-				}else if(dominance == 2){ // q dominates p   ->  increase rank
+			// Apply crossover and mutation
+			variation( parent1, parent2, child[ 0 ], child[ 1 ] );
 
-					_nds_n[ p ] += 1;
+			for( int c = 0; c < 2; c++ ){
 
-				}	
+				// Do not exceed the evaluations budget
+				if( issued >= _max_evaluations ){
+
+					available.push_back( child[ c ] );
+					continue;
+
+				}
 
-			}	
+				SolutionPtr sol = child[ c ];
+				pool.submit( [ sol, &evaluators, &completed_mutex, &completed_cv, &completed ]( int worker ){
+
+					evaluators[ worker ]->evaluate( sol );
+
+					std::lock_guard< std::mutex > lock( completed_mutex );
+					completed.push_back( sol );
+					completed_cv.notify_one();
+
+				});
+
+				issued++;
+				in_flight++;
+
+			}
 
 		}
-		
-		if( _nds_n[ p ] == 0 ){ // p is a member of the first front
 
-			_nds_front[ 0 ][ 0 ]++;
-			_nds_front[ 0 ][ _nds_front[ 0 ][ 0 ] ] = p;		
-			(*pop)[ p ]->rank() = 1;
+		if( in_flight == 0 ) break;
 
+		// Wait for the next evaluated offspring
+		SolutionPtr sol;
+		{
+			std::unique_lock< std::mutex > lock( completed_mutex );
+			completed_cv.wait( lock, [ &completed ]{ return !completed.empty(); } );
+			sol = completed.front();
+			completed.pop_front();
 		}
 
-	}
-		
-	// Compute all other fronts
-	for( i=0; _nds_front[ i ][ 0 ]>0  && i<size-1; i++ ){
-		
-		_nds_front[ i+1 ][ 0 ] = 0;
+		in_flight--;
+		evaluations++;
 
-		for( p=1; p <= _nds_front[ i ][ 0 ]; p++ ){
-			
-			for( q=1; q <= _nds_s[ _nds_front[ i ][ p ] ][ 0 ]; q++ ){
-				
-				_nds_n[ _nds_s[ _nds_front[ i ][ p ] ][ q ] ]--;
-				
-				if( _nds_n[ _nds_s[ _nds_front[ i ][ p ] ][ q ] ] == 0 ){	
+		if( _archive != nullptr ) _archive->insert( sol );
+
+		// Insert offspring, discard worst individual (which may be the offspring itself)
+		ranking.insert( sol );
+		SolutionPtr worst = ranking.remove_worst();
+
+		if( worst != sol ){
 
-					_nds_front[ i+1 ][ 0 ]++;
-					_nds_front[ i+1 ][ _nds_front[ i+1 ][ 0 ] ] = _nds_s[ _nds_front[ i ][ p ] ][ q ];
-					(*pop)[ _nds_s[ _nds_front[ i ][ p ] ][ q ] ]->rank() = i+2;	
+			for( int i = 0; i < _population_size; i++ ){
+
+				if( (*_population)[ i ] == worst ){
+
+					_population->set( i, sol );
+					break;
 
 				}
 
-			}		
+			}
 
 		}
 
-	}			
+		available.push_back( worst );
+
+		// A generation is counted every _population_size offspring
+		if( ( evaluations - _evaluator->total_evaluations() ) % _population_size != 0 ) continue;
+		_generation++;
+
+		// Convergence tracking
+		track_hypervolume( evaluations );
+
+		#ifdef DISPLAY_PROGRESS_MESSAGES
+			cout << "\tGeneration: " << _generation << " ( " << evaluations << " evaluations )" << endl;
+		#endif
+
+		// Report rank-1 front every _frequency generations
+		if( _frequency > 0 && _generation % _frequency == 0 ) snapshot();
+
+	}
+
+	// Return containers to the offspring population
+	for( int i = 0; i < int( available.size() ); i++ ) _offspring->add( available[ i ] );
+
+	// Free memory
+	for( int w = 0; w < pool.size(); w++ ) delete evaluators[ w ];
 
 }
 ////////////////////////////////////////////////////////////////////////////////
-// Compute the crowding distance for solutions in each front
-void Nsga2::crowding_distance_fronts( PopulationPtr pop ){
-	
-	for( int f = 0; f < pop->size() && _nds_front[ f ][ 0 ] > 0; f++ ){ 		
+// Records the hypervolume of the current rank-1 solutions and checks the early stopping 
+// condition: relative hypervolume gain below _hv_epsilon over the last _hv_window generations
+void Nsga2::track_hypervolume( unsigned long evaluations ){
 
-		// Compute crowding distance of the f-th front
-		crowding_distance( pop, _nds_front[ f ] );	
+	_hypervolume->record( _generation, evaluations, _hypervolume->compute( _population ) );
+
+	if( _hv_epsilon > 0.0 && _hypervolume->converged( _hv_epsilon, _hv_window ) ){
+
+		_converged = true;
+
+		#ifdef DISPLAY_PROGRESS_MESSAGES
+			cout << "	Converged: relative hypervolume gain below " << _hv_epsilon << " over " << _hv_window << " generations" << endl;
+		#endif
 
 	}
 
 }
 ////////////////////////////////////////////////////////////////////////////////
-// Compute the crowding distance of the given population 
-// Only consider solutions in the given front
-void Nsga2::crowding_distance( PopulationPtr pop, VectorIntPtr front ){
-	
-	// Initialise
-	for( int i = 1; i <= front[ 0 ]; i++ ) (*pop)[ front[ i ] ]->crowding_distance() = 0.0;
+// Hands a compact copy of the current rank-1 front to the background writer
+// Written as <output>_gen<generation>_final_rank1_measures.txt, etc.
+void Nsga2::snapshot(){
 
-	// Compute crowding distance
-	for( int m = 0; m < num_objectives; m++ ){
-		
-		// Get (idx, val) tuples
-		for( int i = 1, ctr = 0; i <= front[ 0 ]; i++ ){	
+	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
 
-			// Insert idx
-            idx_val_tuples[ ctr++ ] = double( front[ i ] );
+	ParetoArchivePtr front = ParetoArchivePtr( new ParetoArchive( _population_size, _representation ) );
+	for( int i = 0; i < _population->size(); i++ ){
 
-            // Insert objective value
-            idx_val_tuples[ ctr++ ] = (*pop)[ front[ i ] ]->objective( m );
-			
-		}
-				
-		// Sort tuples
-        qsort( (void *)idx_val_tuples, front[ 0 ], (2*sizeof(double)), compare_ascending_tuple );       
+		if( (*_population)[ i ]->rank() == 1 ) front->insert( (*_population)[ i ] );
 
-		if( idx_val_tuples[ 1 ] != idx_val_tuples[ 2*front[ 0 ]-1 ] ){
-		
-			// Assign INF to extreme solutions
-			(*pop)[ idx_val_tuples[ 0 ] ]->crowding_distance() = INF;	// Best soltion m-th objective
+	}
 
-			// Add cuboid distance for all other solutions
-			for( int i = 1; i < front[ 0 ]-1; i++ ){ // idx: i*2, value: i*2+1		
+	_snapshots->submit( _out_filename + "_gen" + to_string( _generation ), front );
 
-				if( (*pop)[ idx_val_tuples[ i*2 ] ]->crowding_distance() != INF ){
+}
+////////////////////////////////////////////////////////////////////////////////
+// Waits until all intermediate results have been written
+// (the writer creates solutions through this object, so it must not outlive the search)
+void Nsga2::finish_snapshots(){
 
-					// (*pop)[ idx_val_tuples[ i*2 ] ]->crowding_distance() += ( idx_val_tuples[ (i+1)*2+1 ] - idx_val_tuples[ (i-1)*2+1 ] ); // Without Normalization
-					(*pop)[ idx_val_tuples[ i*2 ] ]->crowding_distance() += ( idx_val_tuples[ (i+1)*2+1 ] - idx_val_tuples[ (i-1)*2+1 ] ) / ( idx_val_tuples[ 2*front[ 0 ]-1 ] - idx_val_tuples[ 1 ] ); // With Normalization
+	delete _snapshots;
+	_snapshots = nullptr;
 
-				}
+}
+////////////////////////////////////////////////////////////////////////////////
+// Name of the checkpoint file (based on the output filename)
+string Nsga2::checkpoint_filename(){
 
-			}
+	return ( _out_filename.empty() ? _algorithm_name + "_output" : _out_filename ) + "_checkpoint.bin";
 
-		}
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writes the state of the search: configuration (to validate resumption), counters, 
+// state of the random numbers generator, mating permutation and parent population
+// Offspring and auxiliary populations do not carry information between generations
+void Nsga2::write_checkpoint(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tWriting checkpoint: " + checkpoint_filename() << endl;
+	#endif
+
+	Checkpoint checkpoint( checkpoint_filename(), true );
+
+	// Configuration
+	checkpoint.put_string( _representation );
+	checkpoint.put< int32_t >( encoding_length() );
+	checkpoint.put< uint64_t >( PROBLEM->signature( encoding_length() ) );
+	checkpoint.put< uint64_t >( Context::current()->seed );
+	checkpoint.put< int32_t >( mock_L );
+	checkpoint.put< int32_t >( _population_size );
+
+	// Counters
+	checkpoint.put< int32_t >( _generation );
+	checkpoint.put< uint64_t >( _evaluator->total_evaluations() );
+	_hypervolume->put( checkpoint );
+
+	// External archive
+	checkpoint.put< int32_t >( _archive_size );
+	checkpoint.put< double >( _archive_epsilon );
+	if( _archive != nullptr ) _archive->put( checkpoint );
+
+	// Random numbers generator
+	ostringstream state;
+	state << *rnd;
+	checkpoint.put_string( state.str() );
+
+	// Mating permutation and parent population
+	checkpoint.put( parents, _population_size );
+	for( int i = 0; i < _population_size; i++ ) checkpoint.put_solution( (*_population)[ i ] );
+
+	checkpoint.commit();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Restores the state of the search from the latest checkpoint (replaces start())
+void Nsga2::read_checkpoint(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tReading checkpoint: " + checkpoint_filename() << endl;
+	#endif
+
+	// Problem information required by the representation
+	prepare_problem();
+
+	Checkpoint checkpoint( checkpoint_filename(), false );
+
+	// Validate configuration
+	if( checkpoint.get_string() != _representation ) error_message_exit( "Checkpoint was written with a different representation (--representation)" );
+	if( checkpoint.get< int32_t >() != encoding_length() ) error_message_exit( "Checkpoint was written with a different encoding length (--delta)" );
+	if( checkpoint.get< uint64_t >() != PROBLEM->signature( encoding_length() ) ) error_message_exit( "Checkpoint was written for a different problem instance (--file, --seed, --delta)" );
+	if( checkpoint.get< uint64_t >() != Context::current()->seed ) error_message_exit( "Checkpoint was written with a different seed (--seed)" );
+	if( checkpoint.get< int32_t >() != mock_L ) error_message_exit( "Checkpoint was written with a different L parameter (--lparameter)" );
+	if( checkpoint.get< int32_t >() != _population_size ) error_message_exit( "Checkpoint was written with a different population size (--population)" );
+
+	// Counters
+	_generation = checkpoint.get< int32_t >();
+	_evaluator = create_evaluator();
+	_evaluator->set_total_evaluations( checkpoint.get< uint64_t >() );
+	_hypervolume->get( checkpoint );
+
+	// External archive
+	if( checkpoint.get< int32_t >() != _archive_size || checkpoint.get< double >() != _archive_epsilon ){
+
+		error_message_exit( "Checkpoint was written with a different archive configuration (--archive, --archivegrid)" );
+
+	}
+	if( _archive != nullptr ) _archive->get( checkpoint );
+
+	// Random numbers generator
+	istringstream state( checkpoint.get_string() );
+	state >> *rnd;
+
+	// Mating permutation and parent population
+	checkpoint.get( parents, _population_size );
+	for( int i = 0; i < _population_size; i++ ){
+
+		SolutionPtr sol = create_solution();
+		checkpoint.get_solution( sol );
+		_population->add( sol );
 
 	}
 
-	// NOTE: Original NSGA-II code implements an additional step where the obtained crowding distance
-	// values are divided by the number of objectives. However, this does not change rank ordering of 
-	// solutions, and therefore is not here implemented for the sake of efficiency.
+	// Offspring population (containers)
+	for( int i = 0; i < _population_size; i++ ) _offspring->add( create_solution() );
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tGeneration: " << _generation << " ( " << _evaluator->total_evaluations() << " evaluations, resumed )" << endl;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Mating selection, crossover and mutation
+void Nsga2::selection_variation(){	
+
+	variation_blocks( [ this ]( SolutionPtr parent1, SolutionPtr parent2, SolutionPtr child1, SolutionPtr child2 ){
+
+		variation( parent1, parent2, child1, child2 );
+
+	});
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Crossover and mutation of a single pair of parents
+void Nsga2::variation( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2 ){
 
-}	
+	(*crossover_operator)( parent1, parent2, child1, child2, _crossover_prob );
+	(*mutation_operator)( child1, _mutation_prob ); 
+	(*mutation_operator)( child2, _mutation_prob ); 
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Binary tournament selection
+SolutionPtr Nsga2::binary_tournament( SolutionPtr p1, SolutionPtr p2 ){
+
+	// First criterion: dominance
+	int dominance = pareto_dominance( p1->objective(), p2->objective(), num_objectives );
+	if( dominance == 1 ) return p1;
+	if( dominance == 2 ) return p2;
+
+	// Second criterion: crowding
+	if( p1->crowding_distance() > p2->crowding_distance() ) return p1;
+	if( p1->crowding_distance() < p2->crowding_distance() ) return p2;
+
+	// Otherwise: random decision
+	return ( random_real(0, 1) < 0.5 ) ? p1 : p2;
+
+}
 ////////////////////////////////////////////////////////////////////////////////
 // NSGA-II replacement strategy based on nondominated sorting and crowding distance
 void Nsga2::nsga2_replecement( PopulationPtr source, PopulationPtr selected, PopulationPtr nonselected ){
 
-	int f, i, ctr;
+	int f, i, size;
+	VectorIntPtr front;
 
 	// Rank combined population by means of Nondominated Sorting
-	nondominated_sorting( source );		
+	_nds->sort( source );		
 
 	// Fill new population based on the computed ranks, use crowding distance as secondary criterion
 	// Select _population_size individuals from the 2*_population_size individuals of the merged population
@@ -736,47 +1421,38 @@ void Nsga2::nsga2_replecement( PopulationPtr source, PopulationPtr selected, Pop
 		// Even if this is not always necessary to discriminate in survival selection,
 		// crowding is used in mating selection as a secondary criterion, thus
 		// needs to be computed for all selected individuals
-		crowding_distance( source, _nds_front[ f ] );	
+		_nds->crowding_distance( source, f );	
+
+		front = _nds->front( f );
+		size = _nds->front_size( f );
 
 		// Space available for all individuals in this front?
-		if( selected->size() + _nds_front[ f ][ 0 ] <= _population_size ){
+		if( selected->size() + size <= _population_size ){
 
 			// Yes: add all individuals to the population
-			for( i = 1; i <= _nds_front[ f ][ 0 ]; i++ ){
+			for( i = 0; i < size; i++ ){
 
-				selected->add( (*source)[ _nds_front[ f ][ i ] ] ); 
+				selected->add( (*source)[ front[ i ] ] ); 
 
 			}
 
 		}else{
 
 			// No: use crowding as a secondary criterion
-
-			// Get (idx, val) tuples
-			for( i = 1, ctr = 0; i <= _nds_front[ f ][ 0 ]; i++ ){
-
-				// Insert idx
-            	idx_val_tuples[ ctr++ ] = double( _nds_front[ f ][ i ] );
-
-            	// Insert cwd value
-            	idx_val_tuples[ ctr++ ] = (*source)[ _nds_front[ f ][ i ] ]->crowding_distance();
-
-			}
-
-			// Sort tuples in descending order of cwd (cwd is to be maximised)
-        	qsort( (void *)idx_val_tuples, _nds_front[ f ][ 0 ], (2*sizeof(double)), compare_descending_tuple ); 
+			// Sort front in descending order of cwd (cwd is to be maximised)
+			_nds->sort_by_crowding( source, f );
 
         	// Fill population with individuals in the less	crowded regions		
         	for( i = 0; selected->size() < _population_size; i++ ){ 
 
-        		selected->add( (*source)[ idx_val_tuples[ i*2 ] ] ); 
+        		selected->add( (*source)[ front[ i ] ] ); 
 
         	}
 
 			// The rest of the individuals are copied to children
-			for( ; i < _nds_front[ f ][ 0 ]; i++ ){
+			for( ; i < size; i++ ){
 
-				nonselected->add( (*source)[ idx_val_tuples[ i*2 ] ] ); 
+				nonselected->add( (*source)[ front[ i ] ] ); 
 
 			}
 
@@ -785,11 +1461,13 @@ void Nsga2::nsga2_replecement( PopulationPtr source, PopulationPtr selected, Pop
 	}
 
 	// Remaining nonselected individuals need to be copied to children population
-	// for( ; nonselected->size() < _population_size; f++ ){
-	for( ; (selected->size() + nonselected->size()) < source->size(); f++ ){
+	for( ; f < _nds->num_fronts(); f++ ){
+
+		front = _nds->front( f );
+		size = _nds->front_size( f );
 
-		for( i = 1; i <= _nds_front[ f ][ 0 ]; i++ ) 
-			nonselected->add( (*source)[ _nds_front[ f ][ i ] ] );
+		for( i = 0; i < size; i++ ) 
+			nonselected->add( (*source)[ front[ i ] ] );
 
 	}	
 
@@ -823,77 +1501,57 @@ void Nsga2::replacement(){
 // Only considers nondominated solutions, except for g=1 (initial population)
 void Nsga2::generate_output( int g ){	
 
-	// Rank population by means of Nondominated Sorting
-	nondominated_sorting( _population );
-
-	ofstream file, file2, file3, file4;
-
-	#ifdef DISPLAY_PROGRESS_MESSAGES
-		cout << "Generating output files" << endl;
-	#endif
-
 	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
 
-	// ****************************
-	// MEASURES file
-	// ****************************	
-
-	string measures_filename;
-	measures_filename = _out_filename + "_final_rank1_measures.txt";
-
-	#ifdef DISPLAY_PROGRESS_MESSAGES
-		if( g != -1 ) cout << "\t\t";	
-		cout << "\tWriting file: " + measures_filename << endl;
-	#endif
+	// Output files (timed as a phase of the run report)
+	{
 
-	file.open( measures_filename );
+		PROFILE_PHASE( "output" );
 
-	EvaluatorFullPtr evaluator_full = EvaluatorFullPtr( new EvaluatorFull() );
-	
-	for( int i = 0, ctr = 0; i < _population_size; i++ ){
+		#ifdef DISPLAY_PROGRESS_MESSAGES
+			cout << "Generating output files" << endl;
+		#endif
 
-		if( (*_population)[ i ]->rank() == 1 ){
+		// Report nondominated solutions
+		vector< SolutionPtr > rank1;
+		front( rank1 );
 
-			ctr++;
+		OutputWriter::write( rank1, _out_filename, g != -1 );
 
-			// Decode given solution
-    		ClusteringPtr clustering = (*_population)[ i ]->decode_clustering();
-			
-			// If real clusters labels were provided, we can compute Adjusted Rand Index
-    		if( PROBLEM->labels_provided() ){
+		// Hypervolume trace
+		_hypervolume->write( _out_filename + "_hv_trace.txt" );
 
-    			// Variance, connectivity, k, ARI
-				file << evaluator_full->variance( clustering ) << "\t" << evaluator_full->connectivity( clustering ) << "\t" << clustering->total_clusters() << "\t" << evaluator_full->adjusted_rand_index( clustering ) << endl;
+		// External archive
+		if( _archive != nullptr ){
 
-    		}else{
+			vector< SolutionPtr > members;
+			_archive->members( members, [ this ]{ return create_solution(); } );
+			OutputWriter::write( members, _out_filename + "_archive", g != -1 );
+			for( int i = 0; i < int( members.size() ); i++ ) delete members[ i ];
 
-    			// Variance, connectivity, k
-				file << evaluator_full->variance( clustering ) << "\t" << evaluator_full->connectivity( clustering ) << "\t" << clustering->total_clusters() << endl;
+		}
 
-    		}		
+	}
 
-    		// CLUSTERING
-			string clustering_filename;
-			clustering_filename = _out_filename + "_solution_" + to_string( ctr ) + ".txt";
-			file2.open( clustering_filename );
-			for( int j = 0; j < PROBLEM->ndata(); j++ ){
+	// Run report (phase timers and counters)
+	#if PROFILE_LEVEL > 0
+		Profiler::current().write( _out_filename + "_run_report.json" );
+	#endif
 
-				file2 << clustering->assignment( j ) << endl;
+}
+////////////////////////////////////////////////////////////////////////////////
+// Nondominated (rank-1) solutions of the current population
+void Nsga2::front( vector< SolutionPtr > & rank1 ){
 
-			}
-			file2.close();	
+	// Rank population by means of Nondominated Sorting
+	_nds->sort( _population );
 
-			// Free memory
-    		delete clustering;
+	rank1.clear();
+	for( int i = 0; i < _population_size; i++ ){
 
-		}
+		if( (*_population)[ i ]->rank() == 1 ) rank1.push_back( (*_population)[ i ] );
 
 	}
 
-	delete evaluator_full;
-
-	file.close();	
-
 }
 ////////////////////////////////////////////////////////////////////////////////
-
@@ -39,6 +39,16 @@ Dependencies
 #include "mock_UnaryOperator.hh"
 #include "mock_EvaluatorFull.hh"
 #include "mock_EvaluatorDelta.hh"
+#include "mock_NondominatedSorting.hh"
+#include "mock_ThreadPool.hh"
+#include "mock_IslandModel.fwd.hh"
+#include "mock_OutputWriter.hh"
+#include "mock_Checkpoint.hh"
+#include "mock_Hypervolume.hh"
+#include "mock_Archive.hh"
+#include "mock_PopulationStore.hh"
+#include "mock_KMeans.hh"
+#include "mock_SnapshotWriter.hh"
 
 /******************
 Class definition
@@ -57,6 +67,8 @@ class Nsga2 : public Algorithm {
 
 		PopulationPtr _auxiliary;		// Auxiliary population (for +selection-based replacement strategy)
 
+		PopulationStorePtr _store;		// Contiguous storage of parent and offspring solutions
+
 		EvaluatorPtr _evaluator;		// Collection of performance measures and evaluation functions	
 
 		int _population_size;			// Number of individuals in the GA's population
@@ -73,12 +85,44 @@ class Nsga2 : public Algorithm {
 
 		string _out_filename;			// Name of output file(s)
 
-		int _frequency;					// How often to report results (generations)
+		int _frequency;					// How often to report results (generations, 0: only at the end)
+
+		SnapshotWriterPtr _snapshots;	// Background writer of intermediate results
 
 		string _representation;			// Solutions' encoding to be used
 
 		int _max_solutions;				// Maximum number of solutions to be processed
 
+		bool _steady_state;				// Asynchronous steady-state variant (instead of generational)?
+
+		int _threads;					// Number of threads (offspring generation, or evaluation in the steady-state variant)
+
+		ThreadPoolPtr _pool;			// Workers generating offspring (generational variant, several threads)
+
+		int _checkpoint_frequency;		// How often to write a checkpoint (generations, 0: never)
+
+		bool _resume;					// Resume search from the latest checkpoint?
+
+		HypervolumePtr _hypervolume;	// Hypervolume of the rank-1 solutions along the search
+
+		double _hv_epsilon;				// Early stopping: minimum relative hypervolume gain (0: disabled)...
+
+		int _hv_window;					// ... over this number of generations
+
+		bool _converged;				// Early stopping condition met?
+
+		int _archive_size;				// Maximum size of the external archive (0: no archive)
+
+		double _archive_epsilon;		// Relative box size of the external archive's grid (0: no grid)
+
+		ParetoArchivePtr _archive;		// External archive of all nondominated solutions found
+
+		string _initialisation;			// Initial solutions: MST priority cuts, k-means, k-medoids, or hybrid (priority or k-means)
+
+		int _minibatch;					// Mini-batch size of k-means (0: full Lloyd iterations)
+
+		KMeansPtr _kmeans;				// Partitional clustering of the data (during initialisation only)
+
 		// ---------------------------------			
 		// NOTE: Attributes below are auxiliary structures that could have been defined
 		// locally in the respective methods where they are used. However, these are defined
@@ -86,16 +130,14 @@ class Nsga2 : public Algorithm {
 		// memory (in some cases also initialising) multiple times.
 		// ---------------------------------
 
-		MatrixIntPtr _nds_front;		// Fronts obtained from nondominated sorting procedure
-		
-		MatrixIntPtr _nds_s;			// Auxiliary structure for nds procedure
-		
-		VectorIntPtr _nds_n;			// Auxiliary structure for nds procedure
-
-		VectorDoublePtr idx_val_tuples;	// Auxiliary structure for crowding distance
+		NondominatedSortingPtr _nds;	// Nondominated sorting and crowding distance (fronts of the last ranked population)
 
 		VectorIntPtr parents;			// Permutations of parents used in mating selection
 
+		VectorIntPtr _mating;			// Both permutations of a generation (blocks of 4 parents)
+
+		vector< Random > _streams;		// Random numbers stream of each block of 4 parents
+
 	/******************
 	Methods
 	******************/
@@ -112,26 +154,49 @@ class Nsga2 : public Algorithm {
 		void hybrid_initialisation( bool instantiate_offspring = true );
 		void hybrid_initialisation_short( bool instantiate_offspring = true );
 		void hybrid_initialisation_split( bool instantiate_offspring = true );
-		SolutionPtr create_kmeans_solution( int n );
-		SolutionPtr create_kmeans_solution_short( int n );
-		SolutionPtr create_kmeans_solution_split( int n );
-		SolutionPtr create_kmedoids_solution( int n );
-		SolutionPtr create_kmedoids_solution_short( int n );
-		SolutionPtr create_kmedoids_solution_split( int n );
+		SolutionPtr (Nsga2::*clustered_solution)( int n, ThreadPoolPtr pool );
+		bool clustered_initial_solution();
+		void create_clustered_solutions( vector< std::pair< int, int > > & pending );
+		SolutionPtr create_kmeans_solution( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_kmeans_solution_short( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_kmeans_solution_split( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_kmedoids_solution( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_kmedoids_solution_short( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_kmedoids_solution_split( int n, ThreadPoolPtr pool = nullptr );
+		SolutionPtr create_labels_solution( const vector< int > & labels );
+		SolutionPtr create_labels_solution_short( const vector< int > & labels );
+		SolutionPtr create_labels_solution_split( const vector< int > & labels );
 		SolutionPtr create_priority_solution( int n );
 		SolutionPtr create_priority_solution_short( int n );
 		SolutionPtr create_priority_solution_split( int n );
 
 		// Construction/processing of the initial parent population
 		void generate_evaluate_initial_population();
+		void adopt_population_store();
+
+		// Evaluator suited to the chosen representation
+		EvaluatorPtr create_evaluator( bool batch = true );
+
+		// Asynchronous steady-state main loop
+		void run_steady_state();
 
-		// NDS and crowding
-		void nondominated_sorting( PopulationPtr pop );
-		void crowding_distance( PopulationPtr pop, VectorIntPtr front );
-		void crowding_distance_fronts( PopulationPtr pop );
+		// Convergence tracking (hypervolume trace, early stopping)
+		void track_hypervolume( unsigned long evaluations );
+
+		// Intermediate results (rank-1 front every _frequency generations)
+		void snapshot();
+		void finish_snapshots();
+
+		// Checkpoint/restart
+		string checkpoint_filename();
+		void write_checkpoint();
+		void read_checkpoint();
 
 		// Selection (mating and survival selection strategies)
-		void selection_variation();		
+		virtual void selection_variation();		
+		template < typename Variation >
+		void variation_blocks( Variation variation );
+		virtual void variation( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2 );
 		SolutionPtr binary_tournament( SolutionPtr p1, SolutionPtr p2 );
 		void replacement();
 		void nsga2_replecement( PopulationPtr source, PopulationPtr selected, PopulationPtr nonselected );
@@ -146,13 +211,81 @@ class Nsga2 : public Algorithm {
 		Nsga2();
 		virtual ~Nsga2();
 
+		// Factory: instance specialised for the chosen representation (--representation)
+		static Nsga2 * create();
+
 		// Main execution routine
 		virtual void run();
 
+		// Generational execution, one step at a time (used by island model)
+		void start();
+		void step();
+		bool finished();
+		int generation(){ return _generation; }
+		void set_threads( int threads ){ _threads = threads; }
+		int encoding_length();
+		virtual SolutionPtr create_solution();
+		PopulationPtr population(){ return _population; }
+		void prepare_problem();
+
+		// Migration (island model)
+		void emigrate( MigrantBufferPtr ring, int n );
+		void immigrate( MigrantBufferPtr ring );
+
 		// Output generation / configuration details
 		virtual void generate_output( int g = -1 );
+
+		// Nondominated (rank-1) solutions of the current population
+		void front( vector< SolutionPtr > & rank1 );
     
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Mating selection and variation in independent blocks: block k takes parents 4k..4k+3 of the 
+// two mating permutations of the generation, and produces children 2k and 2k+1
+// Each block uses its own random numbers stream (derived from the main generator, jump-ahead), so
+// offspring do not depend on the number of threads or on the order in which blocks are run
+template < typename Variation >
+inline void Nsga2::variation_blocks( Variation variation ){
+
+	// Two permutations of the parents (main generator)
+	shuffle( parents, _population_size );
+	std::copy( parents, parents + _population_size, _mating );
+	shuffle( parents, _population_size );
+	std::copy( parents, parents + _population_size, _mating + _population_size );
+
+	// Streams of the blocks
+	const int blocks = _population_size / 2;
+	Random stream( (*rnd)() );
+	for( int k = 0; k < blocks; k++ ){
+
+		_streams[ k ] = stream;
+		stream.jump();
+
+	}
+
+	auto block = [ this, &variation ]( int k, int worker ){
+
+		RandomPtr main = rnd;
+		rnd = &_streams[ k ];
+
+		// Decide parents by means of tournament selection
+		const int * mating = _mating + 4 * k;
+		SolutionPtr parent1 = binary_tournament( (*_population)[ mating[ 0 ] ], (*_population)[ mating[ 1 ] ] );
+		SolutionPtr parent2 = binary_tournament( (*_population)[ mating[ 2 ] ], (*_population)[ mating[ 3 ] ] );
+
+		// Crossover and mutation
+		variation( parent1, parent2, (*_offspring)[ 2 * k ], (*_offspring)[ 2 * k + 1 ] );
+
+		rnd = main;
+
+	};
+
+	if( _pool != nullptr ) _pool->parallel_for( blocks, block );
+	else for( int k = 0; k < blocks; k++ ) block( k, 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
 #endif
 
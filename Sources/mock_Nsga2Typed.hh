@@ -0,0 +1,100 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_NSGA2TYPED_HH__
+#define __MOCK_NSGA2TYPED_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Nsga2.hh"
+
+/******************
+Class definition
+******************/
+
+// NSGA-II specialised for a given solution type (SolutionLocus, SolutionShort, SolutionSplit)
+// The encoding length, allele generation and variation operators are resolved at compile
+// time, so the generation loop runs without function pointers or per-allele virtual calls
+// Instances are created by Nsga2::create(), based on the chosen representation
+template < typename SolutionType >
+class Nsga2Typed : public Nsga2 {
+
+	/******************
+	Attributes
+	******************/
+
+		// All attributes defined in base class
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Selection and variation
+		void selection_variation();
+		void variation( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2 );
+
+	public:
+
+		// Constructor
+		Nsga2Typed() : Nsga2() {}
+
+		// New (uninitialised) solution object
+		SolutionPtr create_solution(){ return SolutionPtr( new SolutionType( false ) ); }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Crossover and mutation of a single pair of parents (row-based kernels)
+template < typename SolutionType >
+inline void Nsga2Typed< SolutionType >::variation( SolutionPtr const parent1, SolutionPtr const parent2, SolutionPtr child1, SolutionPtr child2 ){
+
+	BinaryOperator::uniform_crossover( parent1->genes(), parent2->genes(), child1->genes(), child2->genes(), SolutionType::static_encoding_length(), _crossover_prob );
+	UnaryOperator::neighbourhood_biased_mutation< SolutionType >( child1->genes(), _mutation_prob );
+	UnaryOperator::neighbourhood_biased_mutation< SolutionType >( child2->genes(), _mutation_prob );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Mating selection, crossover and mutation (blocks of 4 parents, see Nsga2::variation_blocks)
+template < typename SolutionType >
+void Nsga2Typed< SolutionType >::selection_variation(){
+
+	const int length = SolutionType::static_encoding_length();
+	const double crossover_prob = _crossover_prob, mutation_prob = _mutation_prob;
+
+	variation_blocks( [ length, crossover_prob, mutation_prob ]( SolutionPtr parent1, SolutionPtr parent2, SolutionPtr child1, SolutionPtr child2 ){
+
+		BinaryOperator::uniform_crossover( parent1->genes(), parent2->genes(), child1->genes(), child2->genes(), length, crossover_prob );
+		UnaryOperator::neighbourhood_biased_mutation< SolutionType >( child1->genes(), mutation_prob );
+		UnaryOperator::neighbourhood_biased_mutation< SolutionType >( child2->genes(), mutation_prob );
+
+	});
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
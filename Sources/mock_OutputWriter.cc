@@ -0,0 +1,264 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_OutputWriter.hh"
+#include "mock_EvaluatorFull.hh"
+#include "mock_NondominatedSorting.hh"
+#include "mock_ThreadPool.hh"
+#include "mock_ModelSelection.hh"
+#include <sstream>
+#include <cstring>
+#include <zlib.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Format of the cluster labels (--labels): files, binary, csvgz
+string OutputWriter::labels_format(){
+
+	string format = "files";
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--labels" ) format = input_parameters[ i ][ 1 ];
+
+	}
+
+	if( format != "files" && format != "binary" && format != "csvgz" )
+		error_message_exit( "Unrecognised format of the cluster labels (--labels): " + format );
+
+	return format;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Number of threads decoding and evaluating solutions (--threads; 0: hardware concurrency)
+int OutputWriter::threads(){
+
+	int threads = 0;
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--threads" ) threads = stoi( input_parameters[ i ][ 1 ] );
+
+	}
+
+	return ( threads > 0 ) ? threads : ThreadPool::default_threads();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Text of a column of labels, one per line
+void OutputWriter::labels_text( ClusteringPtr clustering, string & text ){
+
+	char buffer[ 16 ];
+
+	text.clear();
+	text.reserve( size_t( PROBLEM->ndata() ) * 4 );
+
+	for( int j = 0; j < PROBLEM->ndata(); j++ ){
+
+		int length = snprintf( buffer, sizeof( buffer ), "%d\n", clustering->assignment( j ) );
+		text.append( buffer, length );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Write measures and clustering files of the given solutions
+// 'nested' only affects the indentation of progress messages
+void OutputWriter::write( vector< SolutionPtr > & solutions, string prefix, bool nested, int threads ){
+
+	const int n = int( solutions.size() );
+	const int ndata = PROBLEM->ndata();
+	const string format = labels_format();
+	const bool selection = ModelSelection::enabled();
+
+	// ****************************
+	// DECODING / EVALUATION (parallel)
+	// ****************************	
+
+	vector< double > variance( n ), connectivity( n ), ari( n );
+	vector< int > clusters( n );
+	vector< int32_t > matrix( ( format == "files" && !selection ) ? 0 : size_t( n ) * ndata );
+
+	int workers = min( ( threads > 0 ) ? threads : OutputWriter::threads(), n );
+	ThreadPoolPtr pool = ( workers > 1 ) ? ThreadPoolPtr( new ThreadPool( workers ) ) : nullptr;
+	if( workers < 1 ) workers = 1;
+
+	vector< EvaluatorFullPtr > evaluator_full( workers );
+	for( int w = 0; w < workers; w++ ) evaluator_full[ w ] = EvaluatorFullPtr( new EvaluatorFull() );
+
+	auto decode = [ & ]( int i, int worker ){
+
+		// Decode given solution
+		ClusteringPtr clustering = solutions[ i ]->decode_clustering();
+
+		variance[ i ] = evaluator_full[ worker ]->variance( clustering );
+		connectivity[ i ] = evaluator_full[ worker ]->connectivity( clustering );
+		clusters[ i ] = clustering->total_clusters();
+
+		// If real clusters labels were provided, we can compute Adjusted Rand Index
+		if( PROBLEM->labels_provided() ) ari[ i ] = evaluator_full[ worker ]->adjusted_rand_index( clustering );
+
+		// CLUSTERING
+		if( format == "files" ){
+
+			string text;
+			labels_text( clustering, text );
+
+			ofstream file2( prefix + "_solution_" + to_string( i+1 ) + ".txt" );
+			file2.write( text.data(), text.size() );
+
+		}
+
+		if( !matrix.empty() ){
+
+			int32_t * row = &matrix[ size_t( i ) * ndata ];
+			for( int j = 0; j < ndata; j++ ) row[ j ] = clustering->assignment( j );
+
+		}
+
+		// Free memory
+		delete clustering;
+
+	};
+
+	if( pool != nullptr ) pool->parallel_for( n, decode );
+	else for( int i = 0; i < n; i++ ) decode( i, 0 );
+
+	for( int w = 0; w < workers; w++ ) delete evaluator_full[ w ];
+
+	// Model selection (recommendation file)
+	if( selection ) ModelSelection::write( matrix, variance, connectivity, clusters, ari, prefix, pool );
+	delete pool;
+
+	// ****************************
+	// MEASURES file
+	// ****************************	
+
+	string measures_filename;
+	measures_filename = prefix + "_final_rank1_measures.txt";
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		if( nested ) cout << "\t\t";	
+		cout << "\tWriting file: " + measures_filename << endl;
+	#endif
+
+	std::ostringstream measures;
+
+	for( int i = 0; i < n; i++ ){
+
+		// Variance, connectivity, k[, ARI]
+		measures << variance[ i ] << "\t" << connectivity[ i ] << "\t" << clusters[ i ];
+		if( PROBLEM->labels_provided() ) measures << "\t" << ari[ i ];
+		measures << "\n";
+
+	}
+
+	ofstream file( measures_filename );
+	file << measures.str();
+	file.close();	
+
+	// ****************************
+	// LABELS matrix
+	// ****************************	
+
+	if( format == "binary" ){
+
+		ofstream file2( prefix + "_labels.bin", std::ios::binary );
+		int32_t header[ 3 ] = { 0, n, ndata };
+		std::memcpy( header, "DMCL", 4 );
+		file2.write( reinterpret_cast< const char * >( header ), sizeof( header ) );
+		file2.write( reinterpret_cast< const char * >( matrix.data() ), matrix.size() * sizeof( int32_t ) );
+
+	}else if( format == "csvgz" ){
+
+		gzFile file2 = gzopen( ( prefix + "_labels.csv.gz" ).c_str(), "wb" );
+		if( file2 == nullptr ) error_message_exit( "Cannot write file: " + prefix + "_labels.csv.gz" );
+
+		string text;
+		char buffer[ 16 ];
+
+		for( int i = 0; i < n; i++ ){
+
+			text.clear();
+
+			for( int j = 0; j < ndata; j++ ){
+
+				int length = snprintf( buffer, sizeof( buffer ), ( j + 1 < ndata ) ? "%d," : "%d\n", int( matrix[ size_t( i ) * ndata + j ] ) );
+				text.append( buffer, length );
+
+			}
+
+			gzwrite( file2, text.data(), unsigned( text.size() ) );
+
+		}
+
+		gzclose( file2 );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Rank the given population and write its nondominated solutions
+// Used to merge several populations (e.g. islands), which may contain copies of the same 
+// solution; solutions with identical genotypes are written once
+void OutputWriter::write_nondominated( PopulationPtr pop, string prefix, bool nested ){
+
+	// Rank population; members of the first front are in ascending order 
+	// of the objectives, thus identical solutions are contiguous
+	NondominatedSortingPtr nds = NondominatedSortingPtr( new NondominatedSorting( pop->size() ) );
+	nds->sort( pop );
+
+	VectorIntPtr front = nds->front( 0 );
+	vector< SolutionPtr > rank1;
+
+	for( int i = 0, first = 0; i < nds->front_size( 0 ); i++ ){
+
+		SolutionPtr sol = (*pop)[ front[ i ] ];
+
+		// First solution with these objective values?
+		if( i == 0 || sol->objective( 0 ) != rank1.back()->objective( 0 ) || sol->objective( 1 ) != rank1.back()->objective( 1 ) ){
+
+			first = int( rank1.size() );
+
+		}
+
+		// Discard if an identical genotype has already been reported
+		bool duplicate = false;
+		for( int k = first; k < int( rank1.size() ) && !duplicate; k++ ){
+
+			duplicate = true;
+			for( int e = 0; e < sol->encoding_length() && duplicate; e++ ) duplicate = ( (*sol)[ e ] == (*rank1[ k ])[ e ] );
+
+		}
+
+		if( !duplicate ) rank1.push_back( sol );
+
+	}
+
+	write( rank1, prefix, nested );
+
+	delete nds;
+
+}
+////////////////////////////////////////////////////////////////////////////////
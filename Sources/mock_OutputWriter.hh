@@ -0,0 +1,78 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_OUTPUTWRITER_HH__
+#define __MOCK_OUTPUTWRITER_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_OutputWriter.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Solution.hh"
+#include "mock_Population.hh"
+#include "mock_Clustering.hh"
+
+/******************
+Class definition
+******************/
+
+// Generation of output files for a set of (nondominated) solutions:
+// 	<prefix>_final_rank1_measures.txt 	one line per solution (variance, connectivity, k[, ARI])
+// and the cluster label of each data element, either one file per solution (--labels files, default)
+// 	<prefix>_solution_<i>.txt 			labels of the i-th solution, one per line
+// or a single matrix with one row per solution
+// 	<prefix>_labels.bin 				(--labels binary) header "DMCL", rows, columns (int32), then int32 labels, row-major
+// 	<prefix>_labels.csv.gz 				(--labels csvgz) gzip-compressed, comma-separated
+// 	<prefix>_model_selection.txt 		(--selection true) solutions ranked by knee and silhouette (see ModelSelection)
+// Solutions are decoded and evaluated in parallel (--threads); each file is written in a single operation
+class OutputWriter{
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		static int threads();
+
+		// Text of a column of labels, one per line
+		static void labels_text( ClusteringPtr clustering, string & text );
+
+	public:
+
+		// Format of the cluster labels (--labels; exits if unrecognised)
+		static string labels_format();
+
+		// Write measures and clustering files of the given solutions (threads: 0 for --threads)
+		static void write( vector< SolutionPtr > & solutions, string prefix, bool nested = false, int threads = 0 );
+
+		// Rank the given population and write its nondominated solutions
+		// (solutions with identical genotypes are written once)
+		static void write_nondominated( PopulationPtr pop, string prefix, bool nested = false );
+
+};
+
+#endif
@@ -35,7 +35,7 @@ Population::Population( int max ) :
 {
 
 	// Allocate memory and initialise
-	_solution = (SolutionPtr *)( new SolutionPtr [ _max_size ] );
+	_solution = (SolutionPtr *)( allocate_tracked( size_t( _max_size ) * sizeof( SolutionPtr ), "population" ) );
 	for( int i=0; i<_max_size; i++ ) _solution[ i ] = nullptr; 
 
 }
@@ -45,7 +45,7 @@ Population::~Population(){
 
 	// Deallocate memory
 	for( int i=0; i<_max_size; i++ ) delete _solution[ i ];
-	delete[] _solution;
+	deallocate_tracked( _solution );
 	_size = -1;
 	
 }
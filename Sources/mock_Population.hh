@@ -65,6 +65,7 @@ class Population{
 
 		// To add solutions to the population
 		void add( SolutionPtr sol );
+		void set( const int i, SolutionPtr sol );
 		// void add_copy( SolutionPtr sol );
 
 		// Empty population
@@ -80,6 +81,13 @@ inline SolutionPtr Population::operator[]( const int i ){
 
 	return _solution[ i ];
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Replaces the i-th member of the population (assign pointer, no deallocation)
+inline void Population::set( const int i, SolutionPtr sol ){
+
+	_solution[ i ] = sol;
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 
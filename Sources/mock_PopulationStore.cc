@@ -0,0 +1,74 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_PopulationStore.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+PopulationStore::PopulationStore( int rows, int length ) :
+	_rows( rows ),
+	_length( length ),
+	_stride( ( length + 15 ) / 16 * 16 )
+{
+
+	// Allocate memory
+	_genes = allocate_aligned_VectorInt( size_t( _rows ) * _stride, 64, "population_store" );
+	_objectives = allocate_VectorDouble( _rows * num_objectives, "population_store" );
+	_rank = allocate_VectorInt( _rows, "population_store" );
+	_crowding = allocate_VectorDouble( _rows, "population_store" );
+
+	// Padding is never read, but keep the block deterministic
+	std::fill( _genes, _genes + size_t( _rows ) * _stride, 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+PopulationStore::~PopulationStore(){
+
+	// Deallocate memory
+	deallocate_aligned_VectorInt( _genes );
+	deallocate_VectorDouble( _objectives );
+	deallocate_VectorInt( _rank );
+	deallocate_VectorDouble( _crowding );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Moves the members of the population to consecutive rows
+void PopulationStore::adopt( PopulationPtr pop, int first_row ){
+
+	if( first_row < 0 || first_row + pop->size() > _rows ) error_message_exit( "Population does not fit in the population store!" );
+
+	for( int i = 0; i < pop->size(); i++ ){
+
+		SolutionPtr sol = (*pop)[ i ];
+		if( sol->encoding_length() != _length ) error_message_exit( "Encoding length is not consistent with the population store!" );
+
+		int r = first_row + i;
+		sol->attach( row( r ), objectives( r ), &_rank[ r ], &_crowding[ r ] );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
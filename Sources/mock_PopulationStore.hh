@@ -0,0 +1,86 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_POPULATIONSTORE_HH__
+#define __MOCK_POPULATIONSTORE_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_PopulationStore.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Population.hh"
+
+/******************
+Class definition
+******************/
+
+// Contiguous (structure-of-arrays) storage for a fixed number of solutions
+// Genotypes are the rows of a single cache-aligned block (each row starts on a 64-byte
+// boundary); objective vectors, ranks and crowding distances are kept in parallel arrays.
+// Solutions adopted by the store become views of one row: Population objects still hold
+// (and move around) solution pointers, but genotype data no longer lives all over the heap
+class PopulationStore{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		int _rows;							// Number of solutions
+		int _length;						// Encoding length
+		int _stride;						// Distance between consecutive rows (multiple of 16 ints)
+
+		VectorIntPtr _genes;				// Genotypes ( _rows x _stride, aligned )
+		VectorDoublePtr _objectives;		// Objective vectors ( _rows x num_objectives )
+		VectorIntPtr _rank;					// Ranks
+		VectorDoublePtr _crowding;			// Crowding distances
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor / destructor
+		PopulationStore( int rows, int length );
+		~PopulationStore();
+
+		// Accesors
+		int rows(){ return _rows; }
+		int stride(){ return _stride; }
+		VectorIntPtr row( const int i ){ return _genes + size_t( i ) * _stride; }
+		VectorDoublePtr objectives( const int i ){ return _objectives + size_t( i ) * num_objectives; }
+		int & rank( const int i ){ return _rank[ i ]; }
+		double & crowding_distance( const int i ){ return _crowding[ i ]; }
+
+		// Moves the members of the population to consecutive rows, starting at the given one;
+		// they become views of the store (which must outlive them)
+		void adopt( PopulationPtr pop, int first_row );
+
+};
+
+#endif
@@ -0,0 +1,862 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_ProcessIslands.hh"
+#include <cstring>
+#include <limits>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor (takes ownership of the socket, which is set to non-blocking mode)
+Channel::Channel( int fd ) :
+
+	_fd( fd ),
+	_out_sent( 0 ),
+	_closed( false )
+
+{
+
+	fcntl( _fd, F_SETFL, fcntl( _fd, F_GETFL, 0 ) | O_NONBLOCK );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+Channel::~Channel(){
+
+	close( _fd );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Queue a message to be sent
+void Channel::send( uint32_t type, const vector< char > & payload ){
+
+	uint32_t header[ 2 ] = { type, uint32_t( payload.size() ) };
+
+	_out.insert( _out.end(), (char *)( header ), (char *)( header ) + sizeof( header ) );
+	_out.insert( _out.end(), payload.begin(), payload.end() );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Send as much pending output as possible without blocking 
+// Returns true if everything was sent (output to a closed connection is discarded)
+bool Channel::flush(){
+
+	while( _out_sent < _out.size() ){
+
+		ssize_t n = ::send( _fd, _out.data() + _out_sent, _out.size() - _out_sent, MSG_NOSIGNAL );
+
+		if( n > 0 ){
+
+			_out_sent += n;
+
+		}else if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ){
+
+			return false;
+
+		}else if( n < 0 && errno == EINTR ){
+
+			continue;
+
+		}else{
+
+			_closed = true;
+			break;
+
+		}
+
+	}
+
+	_out.clear();
+	_out_sent = 0;
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Send all pending output
+void Channel::flush_blocking(){
+
+	while( !flush() ){
+
+		struct pollfd pfd = { _fd, POLLOUT, 0 };
+		poll( &pfd, 1, -1 );
+
+	}
+
+	if( _closed ) error_message_exit( "Island connection closed unexpectedly!" );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Read available input without blocking (false once the peer closed the connection)
+bool Channel::receive(){
+
+	char buffer[ 65536 ];
+
+	while( !_closed ){
+
+		ssize_t n = recv( _fd, buffer, sizeof( buffer ), 0 );
+
+		if( n > 0 ){
+
+			_in.insert( _in.end(), buffer, buffer + n );
+
+		}else if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ){
+
+			break;
+
+		}else if( n < 0 && errno == EINTR ){
+
+			continue;
+
+		}else{
+
+			_closed = true;
+
+		}
+
+	}
+
+	return !_closed;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Extract next complete message, if any
+bool Channel::next( uint32_t & type, vector< char > & payload ){
+
+	uint32_t header[ 2 ];
+
+	if( _in.size() < sizeof( header ) ) return false;
+	memcpy( header, _in.data(), sizeof( header ) );
+	if( _in.size() < sizeof( header ) + header[ 1 ] ) return false;
+
+	type = header[ 0 ];
+	payload.assign( _in.begin() + sizeof( header ), _in.begin() + sizeof( header ) + header[ 1 ] );
+	_in.erase( _in.begin(), _in.begin() + sizeof( header ) + header[ 1 ] );
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Wait for the next complete message
+void Channel::next_blocking( uint32_t & type, vector< char > & payload ){
+
+	while( !next( type, payload ) ){
+
+		if( _closed ) error_message_exit( "Island connection closed unexpectedly!" );
+
+		struct pollfd pfd = { _fd, POLLIN, 0 };
+		poll( &pfd, 1, -1 );
+		receive();
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Stop sending (the peer will read end-of-file)
+void Channel::shutdown_output(){
+
+	shutdown( _fd, SHUT_WR );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Creates a listening socket: "unix:<path>" or "tcp:<port>" (all interfaces, or localhost only)
+int Channel::listen_socket( string address, int backlog, bool loopback ){
+
+	int fd = -1;
+
+	if( address.compare( 0, 5, "unix:" ) == 0 ){
+
+		string path = address.substr( 5 );
+		struct sockaddr_un addr;
+		memset( &addr, 0, sizeof( addr ) );
+		addr.sun_family = AF_UNIX;
+		if( path.size() >= sizeof( addr.sun_path ) ) error_message_exit( "Unix socket path is too long: " + path );
+		strcpy( addr.sun_path, path.c_str() );
+
+		unlink( path.c_str() );
+		fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+		if( fd < 0 || bind( fd, (struct sockaddr *)( &addr ), sizeof( addr ) ) < 0 ) error_message_exit( "Cannot bind socket: " + address );
+
+	}else if( address.compare( 0, 4, "tcp:" ) == 0 ){
+
+		struct sockaddr_in addr;
+		memset( &addr, 0, sizeof( addr ) );
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl( loopback ? INADDR_LOOPBACK : INADDR_ANY );
+		addr.sin_port = htons( stoi( address.substr( 4 ) ) );
+
+		int on = 1;
+		fd = socket( AF_INET, SOCK_STREAM, 0 );
+		if( fd >= 0 ) setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof( on ) );
+		if( fd < 0 || bind( fd, (struct sockaddr *)( &addr ), sizeof( addr ) ) < 0 ) error_message_exit( "Cannot bind socket: " + address );
+
+	}else{
+
+		error_message_exit( "Unrecognised socket address (unix:<path>, tcp:<port>): " + address );
+
+	}
+
+	if( ::listen( fd, backlog ) < 0 ) error_message_exit( "Cannot listen on socket: " + address );
+
+	return fd;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Connects to the given address: "unix:<path>" or "tcp:<host>:<port>"
+// Retries for a while, so that workers can be started before the coordinator
+int Channel::connect_socket( string address ){
+
+	const int attempts = 60;
+
+	for( int attempt = 0; attempt < attempts; attempt++ ){
+
+		int fd = -1;
+
+		if( address.compare( 0, 5, "unix:" ) == 0 ){
+
+			string path = address.substr( 5 );
+			struct sockaddr_un addr;
+			memset( &addr, 0, sizeof( addr ) );
+			addr.sun_family = AF_UNIX;
+			if( path.size() >= sizeof( addr.sun_path ) ) error_message_exit( "Unix socket path is too long: " + path );
+			strcpy( addr.sun_path, path.c_str() );
+
+			fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+			if( fd >= 0 && connect( fd, (struct sockaddr *)( &addr ), sizeof( addr ) ) == 0 ) return fd;
+
+		}else if( address.compare( 0, 4, "tcp:" ) == 0 ){
+
+			size_t colon = address.rfind( ':' );
+			if( colon <= 4 ) error_message_exit( "Unrecognised socket address (tcp:<host>:<port>): " + address );
+			string host = address.substr( 4, colon - 4 ), port = address.substr( colon + 1 );
+
+			struct addrinfo hints, *res = nullptr;
+			memset( &hints, 0, sizeof( hints ) );
+			hints.ai_family = AF_UNSPEC;
+			hints.ai_socktype = SOCK_STREAM;
+
+			if( getaddrinfo( host.c_str(), port.c_str(), &hints, &res ) == 0 ){
+
+				for( struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next ){
+
+					fd = socket( ai->ai_family, ai->ai_socktype, ai->ai_protocol );
+					if( fd >= 0 && connect( fd, ai->ai_addr, ai->ai_addrlen ) == 0 ){
+
+						int on = 1;
+						setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof( on ) );
+						freeaddrinfo( res );
+						return fd;
+
+					}
+					if( fd >= 0 ) close( fd );
+					fd = -1;
+
+				}
+
+				freeaddrinfo( res );
+
+			}
+
+		}else{
+
+			error_message_exit( "Unrecognised socket address (unix:<path>, tcp:<host>:<port>): " + address );
+
+		}
+
+		if( fd >= 0 ) close( fd );
+		sleep( 1 );
+
+	}
+
+	error_message_exit( "Cannot connect to island coordinator: " + address );
+	return -1;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Unix socket address used to communicate with locally forked workers
+string Channel::local_address(){
+
+	return "unix:/tmp/delta_mock_" + to_string( getpid() ) + ".sock";
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+MigrantQueue::MigrantQueue( int length, int capacity ) :
+
+	_length( length ),
+	_capacity( capacity ),
+	_read( 0 )
+
+{
+
+	/* do nothing */
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Serialise solution (false if the queue is full)
+bool MigrantQueue::push( SolutionPtr sol ){
+
+	if( size() >= _capacity ) return false;
+
+	size_t pos = _data.size();
+	_data.resize( pos + record_size() );
+	char *record = _data.data() + pos;
+
+	int32_t kclusters = sol->kclusters();
+	memcpy( record, &kclusters, sizeof( int32_t ) );
+	record += sizeof( int32_t );
+
+	for( int m = 0; m < num_objectives; m++ ){
+
+		double value = sol->objective( m );
+		memcpy( record, &value, sizeof( double ) );
+		record += sizeof( double );
+
+	}
+
+	for( int i = 0; i < _length; i++ ){
+
+		int32_t value = (*sol)[ i ];
+		memcpy( record, &value, sizeof( int32_t ) );
+		record += sizeof( int32_t );
+
+	}
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Overwrite the given solution with the oldest migrant (false if the queue is empty)
+bool MigrantQueue::pop( SolutionPtr sol ){
+
+	if( size() == 0 ) return false;
+
+	const char *record = _data.data() + _read;
+	_read += record_size();
+
+	int32_t kclusters;
+	memcpy( &kclusters, record, sizeof( int32_t ) );
+	record += sizeof( int32_t );
+	sol->kclusters() = kclusters;
+
+	for( int m = 0; m < num_objectives; m++ ){
+
+		memcpy( &sol->objective( m ), record, sizeof( double ) );
+		record += sizeof( double );
+
+	}
+
+	for( int i = 0; i < _length; i++ ){
+
+		int32_t value;
+		memcpy( &value, record, sizeof( int32_t ) );
+		record += sizeof( int32_t );
+		(*sol)[ i ] = value;
+
+	}
+
+	return true;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Append received migrants; beyond capacity, the oldest ones are dropped
+void MigrantQueue::append( const vector< char > & data ){
+
+	if( data.size() % record_size() != 0 ) error_message_exit( "Malformed migrants message!" );
+
+	_data.insert( _data.end(), data.begin(), data.end() );
+
+	if( size() > _capacity ) _read = _data.size() - _capacity * record_size();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+IslandCoordinator::IslandCoordinator( int islands ) : 
+
+	Algorithm( "islands" ),
+	_num_islands( islands ),
+	_nsga2( nullptr ),
+	_gathered( nullptr )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+IslandCoordinator::~IslandCoordinator(){
+
+	// Deallocate memory
+	delete _gathered;
+	delete _nsga2;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void IslandCoordinator::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_address = "";
+	_out_filename = "";
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--listen") ){
+
+			// Wait for workers on the given address (instead of forking them)
+			_address = value;
+
+		}else if( (option == "--output") ){
+
+			// Output filename
+			_out_filename = value;
+
+		}else if( (option == "--steadystate") && (value == "true") ){
+
+			error_message_exit( "The steady-state variant cannot be used in island mode (--steadystate, --processes)" );
+
+		}else if( (option == "--checkpoint") || (option == "--resume") ){
+
+			error_message_exit( "Checkpoints are not supported in island mode (--checkpoint, --resume)" );
+
+		}
+
+	}	
+
+	// Configure method
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configuration of search algorithm based on input and default parameters
+void IslandCoordinator::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _num_islands < 2 ) error_message_exit( "At least two island processes are required (--processes)" );
+
+	// Problem information required by the representation is set up before workers are forked
+	_nsga2 = Nsga2::create();
+	_nsga2->prepare_problem();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine: start (or wait for) workers, relay migrants, gather final solutions
+void IslandCoordinator::run(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Running " + _algorithm_name << " (" << _num_islands << " processes)" << endl;
+	#endif	
+
+	int length = _nsga2->encoding_length();
+	uint64_t signature = PROBLEM->signature( length );
+
+	string address = _address.empty() ? Channel::local_address() : _address;
+	int listener = Channel::listen_socket( address, _num_islands );
+
+	// Fork local workers, which share the problem instance (copy-on-write)
+	vector< pid_t > workers;
+	if( _address.empty() ){
+
+		cout.flush();
+
+		for( int i = 0; i < _num_islands; i++ ){
+
+			pid_t pid = fork();
+			if( pid < 0 ) error_message_exit( "Cannot create island process!" );
+
+			if( pid == 0 ){
+
+				close( listener );
+				IslandWorker worker( address );
+				worker.run();
+				cout.flush();
+				_exit( 0 );
+
+			}
+
+			workers.push_back( pid );
+
+		}
+
+	}
+
+	// Accept connections and verify workers use the same problem instance and encoding
+	vector< ChannelPtr > island( _num_islands, nullptr );
+	uint32_t type;
+	vector< char > payload;
+
+	for( int i = 0; i < _num_islands; i++ ){
+
+		int fd = accept( listener, nullptr, nullptr );
+		if( fd < 0 ){ i--; continue; }
+
+		island[ i ] = new Channel( fd );
+		island[ i ]->next_blocking( type, payload );
+
+		int32_t worker_length;
+		uint64_t worker_signature;
+		if( type != Channel::HELLO || payload.size() != sizeof( int32_t ) + sizeof( uint64_t ) ) error_message_exit( "Unexpected message from island process!" );
+		memcpy( &worker_length, payload.data(), sizeof( int32_t ) );
+		memcpy( &worker_signature, payload.data() + sizeof( int32_t ), sizeof( uint64_t ) );
+
+		if( worker_length != length || worker_signature != signature ){
+
+			error_message_exit( "Island process uses a different problem instance or encoding (data file, seed, delta, representation)!" );
+
+		}
+
+	}
+
+	close( listener );
+	if( address.compare( 0, 5, "unix:" ) == 0 ) unlink( address.substr( 5 ).c_str() );
+
+	// All islands connected: assign identifiers and random number streams (state of the
+	// island's generator: independent stream of the main one, identified by the island index)
+	for( int i = 0; i < _num_islands; i++ ){
+
+		int32_t header[ 2 ] = { i, _num_islands };
+		uint64_t island_state[ 4 ];
+		rnd->stream( i ).get_state( island_state );
+
+		payload.resize( sizeof( header ) + sizeof( island_state ) );
+		memcpy( payload.data(), header, sizeof( header ) );
+		memcpy( payload.data() + sizeof( header ), island_state, sizeof( island_state ) );
+
+		island[ i ]->send( Channel::WELCOME, payload );
+		island[ i ]->flush();
+
+	}
+
+	// Relay migrants from island i to island i+1 until all islands report their final solutions
+	MigrantQueue final( length, std::numeric_limits< int >::max() );
+	int running = _num_islands;
+
+	while( running > 0 ){
+
+		vector< struct pollfd > pfd;
+		vector< int > index;
+
+		for( int i = 0; i < _num_islands; i++ ){
+
+			if( island[ i ] == nullptr ) continue;
+
+			struct pollfd p = { island[ i ]->fd(), short( POLLIN | ( island[ i ]->pending_output() ? POLLOUT : 0 ) ), 0 };
+			pfd.push_back( p );
+			index.push_back( i );
+
+		}
+
+		if( poll( pfd.data(), pfd.size(), -1 ) < 0 && errno != EINTR ) error_message_exit( "Island coordinator: poll failed!" );
+
+		for( int p = 0; p < int( pfd.size() ); p++ ){
+
+			int i = index[ p ];
+
+			if( pfd[ p ].revents & POLLOUT ) island[ i ]->flush();
+			if( !( pfd[ p ].revents & ( POLLIN | POLLHUP | POLLERR ) ) ) continue;
+
+			bool alive = island[ i ]->receive();
+			bool done = false;
+
+			while( !done && island[ i ]->next( type, payload ) ){
+
+				if( type == Channel::MIGRANTS ){
+
+					ChannelPtr target = island[ ( i + 1 ) % _num_islands ];
+					if( target != nullptr ){
+
+						target->send( Channel::MIGRANTS, payload );
+						target->flush();
+
+					}
+
+				}else if( type == Channel::FINAL ){
+
+					final.append( payload );
+					done = true;
+
+				}else{
+
+					error_message_exit( "Unexpected message from island process!" );
+
+				}
+
+			}
+
+			if( done ){
+
+				// Closing the connection lets the worker terminate
+				delete island[ i ];
+				island[ i ] = nullptr;
+				running--;
+
+			}else if( !alive ){
+
+				error_message_exit( "Island process " + to_string( i ) + " terminated before reporting its final solutions!" );
+
+			}
+
+		}
+
+	}
+
+	// Decode gathered solutions
+	_gathered = PopulationPtr( new Population( final.size() ) );
+	while( final.size() > 0 ){
+
+		SolutionPtr sol = _nsga2->create_solution();
+		final.pop( sol );
+		_gathered->add( sol );
+
+	}
+
+	// Wait for local workers
+	for( int i = 0; i < int( workers.size() ); i++ ) waitpid( workers[ i ], nullptr, 0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Reports results - generates output files
+// The nondominated solutions gathered from all islands are merged and reported
+void IslandCoordinator::generate_output( int g ){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Generating output files" << endl;
+	#endif
+
+	if( _out_filename.empty() ) _out_filename = _algorithm_name + "_output";
+
+	{
+		PROFILE_PHASE( "output" );
+		OutputWriter::write_nondominated( _gathered, _out_filename, g != -1 );
+	}
+
+	// Run report (this process only: islands are searched by the worker processes)
+	#if PROFILE_LEVEL > 0
+		Profiler::current().write( _out_filename + "_run_report.json" );
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+IslandWorker::IslandWorker( string address ) : 
+
+	Algorithm( "island" ),
+	_address( address ),
+	_nsga2( nullptr )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+IslandWorker::~IslandWorker(){
+
+	// Deallocate memory
+	delete _nsga2;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void IslandWorker::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_migration_interval = 10;
+	_migrants = 5;
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--migration") ){
+
+			// Generations between migrations (0: isolated islands)
+			_migration_interval = stoi( value );
+
+		}else if( (option == "--migrants") ){
+
+			// Number of migrants
+			_migrants = stoi( value );
+
+		}else if( (option == "--steadystate") && (value == "true") ){
+
+			error_message_exit( "The steady-state variant cannot be used in island mode (--steadystate, --connect)" );
+
+		}else if( (option == "--checkpoint") || (option == "--resume") ){
+
+			error_message_exit( "Checkpoints are not supported in island mode (--checkpoint, --resume)" );
+
+		}
+
+	}	
+
+	// Configure method
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configuration of search algorithm based on input and default parameters
+void IslandWorker::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _migrants < 0 ) error_message_exit( "Number of migrants cannot be negative (--migrants)" );
+
+	_nsga2 = Nsga2::create();
+	_nsga2->prepare_problem();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine: evolve the island, exchange migrants through the coordinator
+void IslandWorker::run(){
+
+	int length = _nsga2->encoding_length();
+	uint32_t type;
+	vector< char > payload;
+
+	Channel channel( Channel::connect_socket( _address ) );
+
+	// Introduce island to the coordinator
+	int32_t hello_length = length;
+	uint64_t signature = PROBLEM->signature( length );
+	payload.resize( sizeof( int32_t ) + sizeof( uint64_t ) );
+	memcpy( payload.data(), &hello_length, sizeof( int32_t ) );
+	memcpy( payload.data() + sizeof( int32_t ), &signature, sizeof( uint64_t ) );
+
+	channel.send( Channel::HELLO, payload );
+	channel.flush_blocking();
+
+	// Wait until all islands are connected; receive identifier and random number stream
+	channel.next_blocking( type, payload );
+	if( type != Channel::WELCOME || payload.size() != 2 * sizeof( int32_t ) + 4 * sizeof( uint64_t ) ) error_message_exit( "Unexpected message from island coordinator!" );
+
+	int32_t header[ 2 ];
+	uint64_t island_state[ 4 ];
+	memcpy( header, payload.data(), sizeof( header ) );
+	memcpy( island_state, payload.data() + sizeof( header ), sizeof( island_state ) );
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Running island " << header[ 0 ] << " of " << header[ 1 ] << endl;
+	#endif	
+
+	delete rnd;
+	rnd = RandomPtr( new Random() );
+	rnd->set_state( island_state );
+
+	// Evolve island
+	MigrantQueue outgoing( length, _migrants );
+	MigrantQueue incoming( length, max( 1, 2 * _migrants ) );
+
+	_nsga2->start();
+
+	while( !_nsga2->finished() ){
+
+		_nsga2->step();
+
+		// Migration
+		if( _migration_interval > 0 && _nsga2->generation() % _migration_interval == 0 ){
+
+			outgoing.clear();
+			_nsga2->emigrate( &outgoing, _migrants );
+			if( outgoing.size() > 0 ) channel.send( Channel::MIGRANTS, outgoing.data() );
+			channel.flush();
+
+			if( !channel.receive() ) error_message_exit( "Island coordinator closed the connection!" );
+			while( channel.next( type, payload ) ){
+
+				if( type == Channel::MIGRANTS ) incoming.append( payload );
+
+			}
+
+			_nsga2->immigrate( &incoming );
+			incoming.clear();
+
+		}
+
+	}
+
+	// Report nondominated solutions
+	PopulationPtr pop = _nsga2->population();
+	MigrantQueue final( length, pop->size() );
+
+	for( int i = 0; i < pop->size(); i++ ){
+
+		if( (*pop)[ i ]->rank() == 1 ) final.push( (*pop)[ i ] );
+
+	}
+
+	channel.send( Channel::FINAL, final.data() );
+	channel.flush_blocking();
+	channel.shutdown_output();
+
+	// Wait until the coordinator closes the connection (discard pending migrants)
+	while( channel.receive() ){
+
+		struct pollfd pfd = { channel.fd(), POLLIN, 0 };
+		poll( &pfd, 1, -1 );
+
+		while( channel.next( type, payload ) ){ /* discard */ }
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
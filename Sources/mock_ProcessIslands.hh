@@ -0,0 +1,242 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_PROCESSISLANDS_HH__
+#define __MOCK_PROCESSISLANDS_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_ProcessIslands.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Algorithm.hh"
+#include "mock_Nsga2.hh"
+#include "mock_IslandModel.hh"
+
+/******************
+Class definition
+******************/
+
+// Stream socket (Unix or TCP) exchanging framed messages: [ type | payload length | payload ]
+// Sending and receiving are buffered and non-blocking, so that a single process can serve
+// several connections; blocking variants are provided for simple request/reply steps
+// Addresses: "unix:<path>", "tcp:<host>:<port>" (connect) or "tcp:<port>" (listen)
+class Channel{
+
+	/******************
+	Attributes
+	******************/
+
+	public:
+
+		// Message types
+		enum MessageType : uint32_t { HELLO = 1, WELCOME = 2, MIGRANTS = 3, FINAL = 4 };
+
+	private:
+
+		int _fd;						// Socket descriptor
+
+		vector< char > _in;				// Received bytes not yet consumed
+
+		vector< char > _out;			// Bytes pending to be sent
+
+		size_t _out_sent;				// Number of bytes of _out already sent
+
+		bool _closed;					// Peer closed the connection?
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor / destructor (takes ownership of the socket)
+		Channel( int fd );
+		~Channel();
+
+		int fd(){ return _fd; }
+		bool closed(){ return _closed; }
+		bool pending_output(){ return _out_sent < _out.size(); }
+
+		// Queue a message to be sent
+		void send( uint32_t type, const vector< char > & payload );
+
+		// Send as much pending output as possible without blocking (true if everything was sent)
+		bool flush();
+		void flush_blocking();
+
+		// Read available input without blocking (false once the peer closed the connection)
+		bool receive();
+
+		// Extract next complete message, if any
+		bool next( uint32_t & type, vector< char > & payload );
+		void next_blocking( uint32_t & type, vector< char > & payload );
+
+		// Stop sending (the peer will read end-of-file)
+		void shutdown_output();
+
+		// Socket set-up
+		static int listen_socket( string address, int backlog, bool loopback = false );
+		static int connect_socket( string address );
+		static string local_address();
+
+};
+
+// Migrants serialised as fixed-size records: [ kclusters | objectives | genotype ]
+// Used to build the payload of MIGRANTS and FINAL messages
+class MigrantQueue : public MigrantBuffer {
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		int _length;					// Encoding length of the migrants
+
+		int _capacity;					// Maximum number of migrants stored
+
+		vector< char > _data;			// Serialised migrants
+
+		size_t _read;					// Position of the next migrant to be popped
+
+	/******************
+	Methods
+	******************/
+
+	public:
+
+		// Constructor
+		MigrantQueue( int length, int capacity );
+
+		// Size of a serialised migrant (bytes)
+		size_t record_size() const { return sizeof( int32_t ) * ( _length + 1 ) + sizeof( double ) * num_objectives; }
+
+		// Number of migrants not yet popped
+		int size() const { return int( ( _data.size() - _read ) / record_size() ); }
+
+		virtual bool push( SolutionPtr sol );
+		virtual bool pop( SolutionPtr sol );
+
+		// Serialised migrants / append received migrants (beyond capacity, oldest are dropped)
+		const vector< char > & data(){ return _data; }
+		void append( const vector< char > & data );
+		void clear(){ _data.clear(); _read = 0; }
+
+};
+
+// Multi-process island model: coordinator process
+// Islands are Nsga2 populations running in separate processes (IslandWorker), connected to
+// the coordinator through stream sockets. Migrants sent by island i are relayed to island i+1,
+// and the final nondominated solutions of all islands are gathered and merged.
+// By default, the coordinator forks the worker processes itself after the problem instance 
+// has been set up (workers share it copy-on-write) and uses a Unix socket. If an address is 
+// given (--listen), it instead waits for workers started with --connect, possibly on other 
+// machines; these load their own problem instance, which must be identical (same data file,
+// seed, delta and representation)
+class IslandCoordinator : public Algorithm {
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		int _num_islands;					// Number of worker processes
+
+		string _address;					// Listening address (empty: fork local workers)
+
+		string _out_filename;				// Name of output file(s)
+
+		Nsga2 * _nsga2;						// Local instance: problem set-up and decoding of gathered solutions
+
+		PopulationPtr _gathered;			// Nondominated solutions received from all islands
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+	public:
+
+		// Constructor / destructor
+		IslandCoordinator( int islands );
+		virtual ~IslandCoordinator();
+
+		// Main execution routine
+		virtual void run();
+
+		// Output generation (merged nondominated solutions of all islands)
+		virtual void generate_output( int g = -1 );
+
+};
+
+// Multi-process island model: worker process running one island
+class IslandWorker : public Algorithm {
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		string _address;					// Address of the coordinator
+
+		Nsga2 * _nsga2;						// Island population
+
+		int _migration_interval;			// Generations between migrations
+
+		int _migrants;						// Number of migrants sent per migration
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+	public:
+
+		// Constructor / destructor
+		IslandWorker( string address );
+		virtual ~IslandWorker();
+
+		// Main execution routine
+		virtual void run();
+
+		// Results are reported by the coordinator
+		virtual void generate_output( int g = -1 ){ /* do nothing */ }
+
+};
+
+#endif
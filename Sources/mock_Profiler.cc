@@ -0,0 +1,158 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Profiler.hh"
+#include "mock_Global.hh"
+#include "mock_Memory.hh"
+
+const char * const Profiler::_counter_names[ Profiler::NUM_COUNTERS ] = { "evaluations", "delta_evaluations", "delta_merges", 
+																		  "mutation_table_hits", "mutation_table_builds" };
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor (times are relative to the creation of the job)
+Profiler::Profiler() : _start( std::chrono::steady_clock::now() ) {
+
+	for( int c = 0; c < NUM_COUNTERS; c++ ) _counters[ c ] = 0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Adds a call of a phase, started at the given wall and CPU times
+void Profiler::record( const char * phase, std::chrono::steady_clock::time_point wall, std::clock_t cpu ){
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double elapsed_wall = std::chrono::duration< double >( now - wall ).count();
+	double elapsed_cpu = double( std::clock() - cpu ) / CLOCKS_PER_SEC;
+	long long peak_rss = Memory::peak_rss();
+
+	std::lock_guard< std::mutex > lock( _mutex );
+
+	int p = 0;
+	while( p < int( _phases.size() ) && _phases[ p ].name != phase ) p++;
+	if( p == int( _phases.size() ) ) _phases.push_back( { phase, 0, 0.0, 0.0, 0, {} } );
+
+	_phases[ p ].calls++;
+	_phases[ p ].wall += elapsed_wall;
+	_phases[ p ].cpu += elapsed_cpu;
+	_phases[ p ].peak_rss = peak_rss;
+	_phases[ p ].memory.resize( Memory::num_tags() );
+	for( int t = 0; t < int( _phases[ p ].memory.size() ); t++ ) _phases[ p ].memory[ t ] = Memory::bytes( t );
+
+	#if PROFILE_LEVEL > 1
+		_trace.push_back( { phase, std::chrono::duration< double >( wall - _start ).count(), elapsed_wall, elapsed_cpu, Memory::tracked(), peak_rss } );
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Accumulated wall time of a phase (0 if never run)
+double Profiler::phase_wall( const std::string & name ){
+
+	for( const Phase & phase : _phases ) if( phase.name == name ) return phase.wall;
+	return 0.0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Report: total times, phases (and memory in use at their end), memory by tag, counters and
+// derived rates (times in seconds, memory in bytes)
+void Profiler::write( const std::string & filename ){
+
+	std::lock_guard< std::mutex > lock( _mutex );
+
+	double wall = std::chrono::duration< double >( std::chrono::steady_clock::now() - _start ).count();
+	double cpu = double( std::clock() ) / CLOCKS_PER_SEC;
+
+	long counter[ NUM_COUNTERS ];
+	for( int c = 0; c < NUM_COUNTERS; c++ ) counter[ c ] = _counters[ c ].load();
+
+	// Evaluation throughput of the search (generational evaluation phases, or the whole steady-state loop)
+	double evaluating = phase_wall( "initial_evaluation" ) + phase_wall( "evaluation" ) + phase_wall( "steady_state" );
+	long lookups = counter[ MUTATION_TABLE_HITS ] + counter[ MUTATION_TABLE_BUILDS ];
+
+	std::vector< Memory::Usage > tags;
+	Memory::usage( tags );
+
+	ofstream file( filename );
+	if( !file.is_open() ) error_message_exit( "Cannot write file: " + filename );
+
+	file.precision( 9 );
+	file << "{\n\t\"profile_level\": " << PROFILE_LEVEL << ",\n\t\"wall_time\": " << wall << ",\n\t\"cpu_time\": " << cpu << ",\n";
+
+	file << "\t\"phases\": [";
+	for( int p = 0; p < int( _phases.size() ); p++ ){
+
+		file << ( p > 0 ? "," : "" ) << "\n\t\t{ \"name\": \"" << _phases[ p ].name << "\", \"calls\": " << _phases[ p ].calls
+			 << ", \"wall\": " << _phases[ p ].wall << ", \"cpu\": " << _phases[ p ].cpu << ", \"peak_rss\": " << _phases[ p ].peak_rss << ", \"memory\": {";
+
+		// Tags with memory in use at the end of the phase
+		bool first = true;
+		for( int t = 0; t < int( _phases[ p ].memory.size() ); t++ ){
+
+			if( _phases[ p ].memory[ t ] == 0 ) continue;
+			file << ( first ? " " : ", " ) << "\"" << tags[ t ].tag << "\": " << _phases[ p ].memory[ t ];
+			first = false;
+
+		}
+		file << ( first ? "" : " " ) << "} }";
+
+	}
+	file << "\n\t],\n";
+
+	file << "\t\"memory\": {\n\t\t\"peak_rss\": " << Memory::peak_rss() << ",\n";
+	if( PROBLEM != nullptr ) file << "\t\t\"plan\": \"" << PROBLEM->plan().describe() << "\",\n";
+	file << "\t\t\"tags\": [";
+	for( int t = 0; t < int( tags.size() ); t++ ){
+
+		file << ( t > 0 ? "," : "" ) << "\n\t\t\t{ \"name\": \"" << tags[ t ].tag << "\", \"bytes\": " << tags[ t ].bytes << ", \"peak\": " << tags[ t ].peak << " }";
+
+	}
+	file << "\n\t\t]\n\t},\n";
+
+	file << "\t\"counters\": {";
+	for( int c = 0; c < NUM_COUNTERS; c++ ) file << ( c > 0 ? "," : "" ) << "\n\t\t\"" << _counter_names[ c ] << "\": " << counter[ c ];
+	file << "\n\t},\n";
+
+	file << "\t\"rates\": {"
+		 << "\n\t\t\"evaluations_per_second\": " << ( evaluating > 0.0 ? counter[ EVALUATIONS ] / evaluating : 0.0 ) << ","
+		 << "\n\t\t\"merges_per_evaluation\": " << ( counter[ DELTA_EVALUATIONS ] > 0 ? double( counter[ DELTA_MERGES ] ) / counter[ DELTA_EVALUATIONS ] : 0.0 ) << ","
+		 << "\n\t\t\"mutation_table_hit_rate\": " << ( lookups > 0 ? double( counter[ MUTATION_TABLE_HITS ] ) / lookups : 0.0 )
+		 << "\n\t}";
+
+	#if PROFILE_LEVEL > 1
+		file << ",\n\t\"trace\": [";
+		for( int e = 0; e < int( _trace.size() ); e++ ){
+
+			file << ( e > 0 ? "," : "" ) << "\n\t\t{ \"phase\": \"" << _trace[ e ].phase << "\", \"start\": " << _trace[ e ].start
+				 << ", \"wall\": " << _trace[ e ].wall << ", \"cpu\": " << _trace[ e ].cpu
+				 << ", \"tracked\": " << _trace[ e ].tracked << ", \"peak_rss\": " << _trace[ e ].peak_rss << " }";
+
+		}
+		file << "\n\t]";
+	#endif
+
+	file << "\n}" << endl;
+
+	file.close();
+
+}
+////////////////////////////////////////////////////////////////////////////////
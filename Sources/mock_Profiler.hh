@@ -0,0 +1,164 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_PROFILER_HH__
+#define __MOCK_PROFILER_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Profiler.fwd.hh"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/******************
+Instrumentation macros
+******************/
+
+// PROFILE_PHASE( "name" ) times the rest of the enclosing block (wall and CPU time) as phase "name"
+// PROFILE_COUNT( COUNTER, n ) adds n to one of the Profiler::Counter counters
+// Both expand to nothing if PROFILE_LEVEL is 0 (mock_Global.hh)
+#define PROFILE_CONCAT_( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_( a, b )
+
+#if PROFILE_LEVEL > 0
+	#define PROFILE_PHASE( name ) Profiler::Scope PROFILE_CONCAT( profile_phase_, __LINE__ )( name )
+	#define PROFILE_COUNT( counter, n ) Profiler::current().count( Profiler::counter, n )
+#else
+	#define PROFILE_PHASE( name )
+	#define PROFILE_COUNT( counter, n )
+#endif
+
+/******************
+Class definition
+******************/
+
+// Run instrumentation of a job (one per Context, see mock_Context.hh), reported as <output>_run_report.json
+// Phases accumulate calls, wall time and CPU time (process time: all threads, so parallel phases 
+// may report more CPU than wall time). Phases may nest (e.g. relevant_edges within initialisation)
+// Counters are relaxed atomics, safe to update from worker threads
+// At the end of each phase, the bytes in use of each memory tag (mock_Memory.hh) and the peak RSS 
+// of the process are kept (as of the last call of the phase)
+// With PROFILE_LEVEL 2, every timed phase is also recorded in a trace (start offset, wall, CPU,
+// tracked bytes, peak RSS), which gives the variation, evaluation and replacement times of each generation
+class Profiler{
+
+	/******************
+	Types
+	******************/
+
+	public:
+
+		enum Counter{ 
+			EVALUATIONS,				// Objective function evaluations (all evaluators)
+			DELTA_EVALUATIONS,			// ... by delta evaluators
+			DELTA_MERGES,				// Pre-computed clusters merged by delta evaluations
+			MUTATION_TABLE_HITS,		// Mutations served by the cached probabilities table
+			MUTATION_TABLE_BUILDS,		// ... requiring the table to be (re)built
+			NUM_COUNTERS 
+		};
+
+		// Times the lifetime of the object as a phase
+		class Scope{
+
+			private:
+
+				const char * _phase;
+				std::chrono::steady_clock::time_point _wall;
+				std::clock_t _cpu;
+
+			public:
+
+				Scope( const char * phase ) : _phase( phase ), _wall( std::chrono::steady_clock::now() ), _cpu( std::clock() ) {}
+				~Scope(){ Profiler::current().record( _phase, _wall, _cpu ); }
+
+		};
+
+	private:
+
+		struct Phase{
+
+			std::string name;
+			long calls;
+			double wall;
+			double cpu;
+			long long peak_rss;					// At the end of the last call
+			std::vector< long long > memory;	// Bytes in use of each memory tag, at the end of the last call
+
+		};
+
+		struct Event{
+
+			const char * phase;
+			double start;
+			double wall;
+			double cpu;
+			long long tracked;
+			long long peak_rss;
+
+		};
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		std::mutex _mutex;
+		std::vector< Phase > _phases;					// In order of first occurrence
+		std::vector< Event > _trace;					// PROFILE_LEVEL 2
+		std::atomic< long > _counters[ NUM_COUNTERS ];
+		static const char * const _counter_names[ NUM_COUNTERS ];
+		const std::chrono::steady_clock::time_point _start;
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		double phase_wall( const std::string & name );
+
+	public:
+
+		Profiler();
+
+		// Instrumentation of the job of the calling thread (defined in mock_Context.hh)
+		static Profiler & current();
+
+		void record( const char * phase, std::chrono::steady_clock::time_point wall, std::clock_t cpu );
+
+		void count( Counter counter, long n ){ _counters[ counter ].fetch_add( n, std::memory_order_relaxed ); }
+
+		// JSON report of all phases and counters so far
+		void write( const std::string & filename );
+
+};
+
+#endif
@@ -0,0 +1,131 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_Random.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor: the state is initialised from the seed by means of splitmix64
+Random::Random( uint64_t seed ){
+
+	for( int i = 0; i < 4; i++ ){
+
+		uint64_t z = ( seed += 0x9e3779b97f4a7c15 );
+		z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9;
+		z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111eb;
+		_s[ i ] = z ^ ( z >> 31 );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Fills the buffer with n uniform reals in [0,1)
+void Random::fill_uniform( double * buffer, int n ){
+
+	for( int i = 0; i < n; i++ ) buffer[ i ] = uniform();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Fills the buffer with n random 64-bit words
+void Random::fill_bits( uint64_t * buffer, int n ){
+
+	for( int i = 0; i < n; i++ ) buffer[ i ] = (*this)();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Advances the state as many steps as given by the jump polynomial
+void Random::jump( const uint64_t * polynomial ){
+
+	uint64_t s[ 4 ] = { 0, 0, 0, 0 };
+
+	for( int i = 0; i < 4; i++ ){
+
+		for( int b = 0; b < 64; b++ ){
+
+			if( polynomial[ i ] & ( uint64_t( 1 ) << b ) ){
+
+				for( int j = 0; j < 4; j++ ) s[ j ] ^= _s[ j ];
+
+			}
+
+			(*this)();
+
+		}
+
+	}
+
+	for( int j = 0; j < 4; j++ ) _s[ j ] = s[ j ];
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Equivalent to 2^128 calls; generates 2^128 non-overlapping subsequences
+void Random::jump(){
+
+	static const uint64_t polynomial[ 4 ] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+	jump( polynomial );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Equivalent to 2^192 calls; generates 2^64 non-overlapping sets of 2^128-long subsequences
+void Random::long_jump(){
+
+	static const uint64_t polynomial[ 4 ] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+	jump( polynomial );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Independent stream for the given task index
+Random Random::stream( int index ) const {
+
+	Random r( *this );
+	for( int i = 0; i <= index; i++ ) r.long_jump();
+	return r;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void Random::get_state( uint64_t * state ) const {
+
+	for( int i = 0; i < 4; i++ ) state[ i ] = _s[ i ];
+
+}
+////////////////////////////////////////////////////////////////////////////////
+void Random::set_state( const uint64_t * state ){
+
+	for( int i = 0; i < 4; i++ ) _s[ i ] = state[ i ];
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Textual state (same interface as the <random> engines)
+std::ostream & operator<<( std::ostream & out, const Random & rnd ){
+
+	return out << rnd._s[ 0 ] << ' ' << rnd._s[ 1 ] << ' ' << rnd._s[ 2 ] << ' ' << rnd._s[ 3 ];
+
+}
+////////////////////////////////////////////////////////////////////////////////
+std::istream & operator>>( std::istream & in, Random & rnd ){
+
+	return in >> rnd._s[ 0 ] >> rnd._s[ 1 ] >> rnd._s[ 2 ] >> rnd._s[ 3 ];
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,150 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_RANDOM_HH__
+#define __MOCK_RANDOM_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Random.fwd.hh"
+#include <cstdint>
+#include <iostream>
+
+/******************
+Class definition
+******************/
+
+// Pseudo-random numbers generator: xoshiro256** (Blackman and Vigna)
+// 256-bit state, seeded from a single 64-bit value through splitmix64. Jump functions advance the 
+// state by 2^128 (jump) or 2^192 (long_jump) steps, providing non-overlapping streams: streams are
+// identified by the index of a task (island, block of offspring...), never by the thread running
+// it, so results for a given seed do not depend on the number of threads.
+// Satisfies the requirements of a uniform random bit generator (usable with <random> distributions)
+class Random{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		uint64_t _s[ 4 ];		// State
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		static uint64_t rotl( const uint64_t x, int k ){ return ( x << k ) | ( x >> ( 64 - k ) ); }
+		void jump( const uint64_t * polynomial );
+
+	public:
+
+		typedef uint64_t result_type;
+
+		// Constructor
+		Random( uint64_t seed = 0 );
+
+		// Next 64 random bits
+		uint64_t operator()();
+		static constexpr uint64_t min(){ return 0; }
+		static constexpr uint64_t max(){ return UINT64_MAX; }
+
+		// Uniform real in [0,1) (53 random bits), uniform integer in [min,max] (unbiased)
+		double uniform();
+		int uniform_int( int min, int max );
+
+		// Bulk generation: uniforms in [0,1), random 64-bit words
+		void fill_uniform( double * buffer, int n );
+		void fill_bits( uint64_t * buffer, int n );
+
+		// Jump-ahead (2^128, 2^192 steps)
+		void jump();
+		void long_jump();
+
+		// Independent stream for the given task index (this generator, advanced by index+1 long jumps)
+		Random stream( int index ) const;
+
+		// State (checkpoints, transfer to other processes)
+		friend std::ostream & operator<<( std::ostream & out, const Random & rnd );
+		friend std::istream & operator>>( std::istream & in, Random & rnd );
+		void get_state( uint64_t * state ) const;
+		void set_state( const uint64_t * state );
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Next 64 random bits (xoshiro256**)
+inline uint64_t Random::operator()(){
+
+	const uint64_t result = rotl( _s[ 1 ] * 5, 7 ) * 9;
+	const uint64_t t = _s[ 1 ] << 17;
+
+	_s[ 2 ] ^= _s[ 0 ];
+	_s[ 3 ] ^= _s[ 1 ];
+	_s[ 1 ] ^= _s[ 2 ];
+	_s[ 0 ] ^= _s[ 3 ];
+	_s[ 2 ] ^= t;
+	_s[ 3 ] = rotl( _s[ 3 ], 45 );
+
+	return result;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Uniform real in [0,1): upper 53 bits scaled by 2^-53
+inline double Random::uniform(){
+
+	return double( (*this)() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Uniform integer in [min,max], by multiplication and rejection of the biased low range (Lemire)
+inline int Random::uniform_int( int min, int max ){
+
+	const uint64_t range = uint64_t( int64_t( max ) - int64_t( min ) ) + 1;
+
+	unsigned __int128 m = ( unsigned __int128 )( (*this)() ) * range;
+	uint64_t low = uint64_t( m );
+
+	if( low < range ){
+
+		const uint64_t threshold = ( 0 - range ) % range;
+		while( low < threshold ){
+
+			m = ( unsigned __int128 )( (*this)() ) * range;
+			low = uint64_t( m );
+
+		}
+
+	}
+
+	return int( int64_t( min ) + int64_t( m >> 64 ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,620 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+
+#include "mock_Service.hh"
+#include "mock_ProcessIslands.hh"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+volatile std::sig_atomic_t Service::_stop = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// String as a JSON string literal
+static string json_string( const string & text ){
+
+	std::ostringstream out;
+	out << '"';
+
+	for( char c : text ){
+
+		if( c == '"' || c == '\\' ) out << '\\' << c;
+		else if( c == '\n' ) out << "\\n";
+		else if( c == '\t' ) out << "\\t";
+		else if( (unsigned char)( c ) < 0x20 ) out << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' ) << int( c ) << std::dec;
+		else out << c;
+
+	}
+
+	out << '"';
+	return out.str();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Leading and trailing blanks removed
+static string trim( const string & text ){
+
+	size_t first = text.find_first_not_of( " \t\r" );
+	if( first == string::npos ) return "";
+
+	return text.substr( first, text.find_last_not_of( " \t\r" ) - first + 1 );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+Service::Service() : 
+
+	Algorithm( "service" ),
+	_requests( 0 ),
+	_hits( 0 )
+
+{
+
+	initialise();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+Service::~Service(){}
+////////////////////////////////////////////////////////////////////////////////
+// Service mode requested? (--serve)
+bool Service::enabled(){
+
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		if( input_parameters[ i ][ 0 ] == "--serve" ) return true;
+
+	}
+
+	return false;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Initialises based on command-line input parameters
+// and invokes configuration of search algorithm
+void Service::initialise(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tInitialising " + _algorithm_name << endl;
+	#endif
+
+	// Set default parameter values
+	_address = "";
+	_jobs = 0;
+	_capacity = 4;
+
+	// Load and set input parameters 
+	// (these override default settings if provided)
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		// Retrieve (option, value) tuple
+		string option = input_parameters[ i ][ 0 ];
+		string value = input_parameters[ i ][ 1 ];
+
+		// Set relevant options
+		if( (option == "--serve") ){
+
+			// Socket address
+			_address = value;
+
+		}else if( (option == "--jobs") ){
+
+			// Number of requests at a time
+			_jobs = stoi( value );
+
+		}else if( (option == "--cache") ){
+
+			// Number of data sets kept pre-computed
+			_capacity = stoi( value );
+
+		}
+
+	}
+
+	configure();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Configures search algorithm: settings common to all requests
+void Service::configure(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "\tConfiguring " + _algorithm_name << endl;
+	#endif
+
+	if( _jobs <= 0 ) _jobs = ThreadPool::default_threads();
+	if( _capacity < 1 ) error_message_exit( "At least one data set must be cached (--cache)" );
+
+	// Command-line options (requests are single-threaded by default)
+	_common = { { "--threads", "1" } };
+	for( int i=0; i<input_parameters.size(); i++ ){
+
+		string option = input_parameters[ i ][ 0 ];
+		if( option == "--serve" || option == "--jobs" || option == "--cache" || option == "--output" || option == "--file" ) continue;
+
+		_common.push_back( { option, input_parameters[ i ][ 1 ] } );
+
+	}
+	_common.push_back( { "--seed", to_string( Context::current()->seed ) } );
+	_common.push_back( { "--lparameter", to_string( mock_L ) } );
+	_common.push_back( { "--kmax", to_string( mock_Kmax ) } );
+	_common.push_back( { "--initialsize", to_string( TOTAL_INITIAL_SOLUTIONS ) } );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Termination requested (signal handler)
+void Service::terminate( int signal ){
+
+	_stop = 1;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main execution routine: accepts connections until SIGINT or SIGTERM is received, each 
+// served by a pool of --jobs threads
+void Service::run(){
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Serving requests on " << _address << " (" << _jobs << " at a time, " << _capacity << " data sets cached)" << endl;
+	#endif
+
+	struct sigaction action;
+	memset( &action, 0, sizeof( action ) );
+	action.sa_handler = terminate;
+	sigaction( SIGINT, &action, nullptr );
+	sigaction( SIGTERM, &action, nullptr );
+
+	int listener = Channel::listen_socket( _address, 64, true );
+
+	{
+
+		ThreadPool pool( _jobs );
+
+		while( !_stop ){
+
+			struct pollfd pfd = { listener, POLLIN, 0 };
+			if( poll( &pfd, 1, 500 ) <= 0 ) continue;
+
+			int fd = accept( listener, nullptr, nullptr );
+			if( fd < 0 ) continue;
+
+			pool.submit( [ this, fd ]( int worker ){ serve( fd ); } );
+
+		}
+
+		close( listener );
+		if( _address.compare( 0, 5, "unix:" ) == 0 ) unlink( _address.substr( 5 ).c_str() );
+
+		// Requests in progress are completed
+		pool.wait();
+
+	}
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		cout << "Service stopped (" << _requests << " requests, " << _hits << " served from the cache)" << endl;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// A connection: reads one HTTP request (request line, headers and a body of Content-Length
+// bytes), replies with JSON and closes the connection
+void Service::serve( int fd ){
+
+	struct timeval timeout = { 60, 0 };
+	setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+
+	string request;
+	char buffer[ 65536 ];
+	size_t end;
+
+	while( ( end = request.find( "\r\n\r\n" ) ) == string::npos ){
+
+		ssize_t n = recv( fd, buffer, sizeof( buffer ), 0 );
+		if( n <= 0 || request.size() > 1048576 ){ close( fd ); return; }
+
+		request.append( buffer, n );
+
+	}
+
+	// Request line and Content-Length header
+	std::istringstream headers( request.substr( 0, end ) );
+	string method, target, line;
+	headers >> method >> target;
+	std::getline( headers, line );
+
+	size_t length = 0;
+	while( std::getline( headers, line ) ){
+
+		size_t colon = line.find( ':' );
+		if( colon == string::npos ) continue;
+
+		string name = line.substr( 0, colon );
+		std::transform( name.begin(), name.end(), name.begin(), ::tolower );
+		if( name == "content-length" ) length = stoul( trim( line.substr( colon + 1 ) ) );
+
+	}
+
+	string body = request.substr( end + 4 );
+	while( body.size() < length ){
+
+		ssize_t n = recv( fd, buffer, sizeof( buffer ), 0 );
+		if( n <= 0 ){ close( fd ); return; }
+
+		body.append( buffer, n );
+
+	}
+
+	// Reply
+	int code = 200;
+	string reply;
+
+	try{
+
+		if( method == "POST" && target == "/cluster" ) reply = cluster( body, code );
+		else if( method == "GET" && target == "/status" ) reply = status();
+		else{
+
+			code = 404;
+			reply = "{\"error\": \"Not found (POST /cluster, GET /status)\"}";
+
+		}
+
+	}catch( const std::logic_error & e ){
+
+		// Conversions of option values (std::invalid_argument, std::out_of_range)
+		code = 400;
+		reply = "{\"error\": " + json_string( string( "Invalid option value (" ) + e.what() + ")" ) + "}";
+
+	}catch( const std::exception & e ){
+
+		code = 400;
+		reply = "{\"error\": " + json_string( e.what() ) + "}";
+
+	}
+
+	std::ostringstream response;
+	response << "HTTP/1.1 " << code << ( code == 200 ? " OK" : code == 404 ? " Not Found" : " Bad Request" ) << "\r\n"
+		<< "Content-Type: application/json\r\nContent-Length: " << reply.size() + 1 << "\r\nConnection: close\r\n\r\n" << reply << "\n";
+
+	string output = response.str();
+	for( size_t sent = 0; sent < output.size(); ){
+
+		ssize_t n = ::send( fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL );
+		if( n < 0 && errno == EINTR ) continue;
+		if( n <= 0 ) break;
+
+		sent += n;
+
+	}
+
+	close( fd );
+
+	#ifdef DISPLAY_PROGRESS_MESSAGES
+		std::ostringstream message;
+		message << method << " " << target << ": " << code << "\n";
+		cout << message.str() << std::flush;
+	#endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Clustering request: options of the run, one per line (values may contain spaces), optionally
+// followed by a line "--data" and the contents of a data file
+// Reply: data set, whether its pre-computations were cached, loading and search times (seconds),
+// and the rank-1 solutions of the final population (objective values, clusters, ARI, labels)
+string Service::cluster( const string & body, int & code ){
+
+	// Options that can be set per request (others are those of the service)
+	const vector< string > allowed = { "--file", "--normalise", "--population", "--crossover", 
+		"--mutation", "--generations", "--representation", "--delta", "--kmax", "--seed", 
+		"--initialsize", "--lparameter", "--evaluations", "--steadystate", "--threads", 
+		"--hvepsilon", "--hvwindow", "--initialisation", "--minibatch" };
+
+	Parameters options;
+	string filename, data, normalise;
+	int L = mock_L;
+	bool inline_data = false;
+
+	std::istringstream lines( body );
+	string line;
+	while( std::getline( lines, line ) ){
+
+		line = trim( line );
+		if( line.empty() || line[ 0 ] == '#' ) continue;
+
+		if( line == "--data" ){
+
+			std::ostringstream rest;
+			rest << lines.rdbuf();
+			data = rest.str();
+			inline_data = true;
+			break;
+
+		}
+
+		size_t space = line.find_first_of( " \t" );
+		string option = line.substr( 0, space );
+		string value = ( space == string::npos ) ? "" : trim( line.substr( space ) );
+		std::transform( option.begin(), option.end(), option.begin(), ::tolower );
+
+		code = 400;
+		if( std::find( allowed.begin(), allowed.end(), option ) == allowed.end() ) return "{\"error\": " + json_string( "Option cannot be set per request: " + option ) + "}";
+		if( value.empty() ) return "{\"error\": " + json_string( "No value was provided for option '" + option + "'" ) + "}";
+
+		if( option == "--file" ) filename = value;
+		else options.push_back( { option, value } );
+
+		if( option == "--normalise" ){
+
+			normalise = value;
+			std::transform( normalise.begin(), normalise.end(), normalise.begin(), ::tolower );
+
+		}
+		if( option == "--lparameter" ) L = stoi( value );
+
+	}
+
+	// Data set: file (identified by its path, size and modification time), or inline (by its contents)
+	code = 400;
+	string key;
+	int ndata, mdim;
+
+	if( inline_data != filename.empty() ) return "{\"error\": \"Either a data file (--file) or inline data (--data) must be given\"}";
+
+	if( inline_data ){
+
+		std::istringstream header( data );
+		if( !( header >> ndata >> mdim ) || ndata < 2 || mdim < 1 ) return "{\"error\": \"Invalid header of inline data\"}";
+
+		key = "inline:" + to_string( std::hash< string >()( data ) ) + ":" + to_string( data.size() );
+
+	}else{
+
+		struct stat status;
+		char * path = realpath( filename.c_str(), nullptr );
+		bool valid = path != nullptr && stat( path, &status ) == 0 && Memory::header( filename, ndata, mdim );
+
+		if( path != nullptr ) key = "file:" + string( path ) + ":" + to_string( status.st_size ) + ":" + to_string( status.st_mtime );
+		free( path );
+
+		if( !valid ) return "{\"error\": " + json_string( "Invalid data file: " + filename ) + "}";
+
+	}
+
+	key += ":" + normalise;
+
+	// Pre-computed data set
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Parameters parameters = _common;
+	if( !normalise.empty() ) parameters.push_back( { "--normalise", normalise } );
+	parameters.push_back( { "--lparameter", to_string( L ) } );
+
+	bool cached;
+	EntryPtr entry = acquire( key, parameters, filename, data, L, cached );
+	std::shared_ptr< Job > shared = entry->job.get();
+
+	double load_time = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+	start = std::chrono::steady_clock::now();
+
+	// Search (sharing the pre-computations)
+	parameters = _common;
+	parameters.insert( parameters.end(), options.begin(), options.end() );
+	parameters.push_back( { "--file", entry->filename } );
+
+	Job job( parameters, shared->problem() );
+	job.set_recoverable( true );
+	job.run();
+
+	const vector< Job::Solution > & front = job.front();
+	double search_time = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+	{
+
+		std::lock_guard< std::mutex > lock( _mutex );
+		_requests++;
+		if( cached ) _hits++;
+
+	}
+
+	// Reply
+	std::ostringstream reply;
+	reply << std::setprecision( 12 );
+	reply << "{\"dataset\": " << json_string( entry->dataset ) << ", \"cached\": " << ( cached ? "true" : "false" )
+		<< ", \"load_seconds\": " << load_time << ", \"search_seconds\": " << search_time << ", \"solutions\": [";
+
+	for( int i = 0; i < int( front.size() ); i++ ){
+
+		reply << ( i > 0 ? ", " : "" ) << "{\"variance\": " << front[ i ].variance << ", \"connectivity\": " << front[ i ].connectivity 
+			<< ", \"clusters\": " << front[ i ].clusters << ", \"ari\": " << front[ i ].ari << ", \"labels\": [";
+
+		for( int j = 0; j < int( front[ i ].labels.size() ); j++ ) reply << ( j > 0 ? "," : "" ) << front[ i ].labels[ j ];
+
+		reply << "]}";
+
+	}
+
+	reply << "]}";
+
+	code = 200;
+	return reply.str();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Status request: number of requests, and cached data sets (most recently used first)
+string Service::status(){
+
+	std::lock_guard< std::mutex > lock( _mutex );
+
+	std::ostringstream reply;
+	reply << "{\"requests\": " << _requests << ", \"cache_hits\": " << _hits << ", \"capacity\": " << _capacity << ", \"cache\": [";
+
+	int i = 0;
+	for( const string & key : _recent ){
+
+		EntryPtr entry = _cache[ key ];
+		bool ready = entry->job.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+
+		reply << ( i++ > 0 ? ", " : "" ) << "{\"dataset\": " << json_string( entry->dataset ) << ", \"ready\": " << ( ready ? "true" : "false" ) 
+			<< ", \"hits\": " << entry->hits << "}";
+
+	}
+
+	reply << "]}";
+	return reply.str();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Pre-computed data set: cached, being loaded by another request, or loaded now (data file, or
+// temporary file with the inline data, read once); once it is loaded, the least recently used
+// beyond --cache are evicted (and released when the requests using them are finished)
+// Loaded again if its neighbour lists are not complete and too short for the L requested
+Service::EntryPtr Service::acquire( const string & key, const Parameters & parameters, const string & filename, const string & data, int L, bool & cached ){
+
+	while( true ){
+
+		EntryPtr entry;
+		std::promise< std::shared_ptr< Job > > loading;
+		bool load = false;
+
+		{
+
+			std::lock_guard< std::mutex > lock( _mutex );
+
+			_recent.remove( key );
+			_recent.push_front( key );
+
+			auto found = _cache.find( key );
+			if( found != _cache.end() ){
+
+				entry = found->second;
+
+			}else{
+
+				entry = EntryPtr( new Entry() );
+				entry->job = loading.get_future().share();
+				entry->dataset = data.empty() ? filename : "inline";
+				entry->filename = filename;
+				entry->L = L;
+				entry->hits = 0;
+				_cache[ key ] = entry;
+				load = true;
+
+			}
+
+		}
+
+		// Loaded by this request
+		if( load ){
+
+			cached = false;
+
+			try{
+
+				if( !data.empty() ){
+
+					char path[] = "/tmp/delta_mock_XXXXXX";
+					int fd = mkstemp( path );
+					if( fd < 0 ) error_message_exit( "Cannot create temporary file for inline data" );
+					close( fd );
+
+					entry->filename = path;
+					ofstream file( entry->filename );
+					file << data;
+
+				}
+
+				Parameters base = parameters;
+				base.push_back( { "--file", entry->filename } );
+
+				std::shared_ptr< Job > job( new Job( base ) );
+				job->set_recoverable( true );
+				job->precompute();
+
+				if( !data.empty() ) unlink( entry->filename.c_str() );
+				loading.set_value( job );
+
+				std::lock_guard< std::mutex > lock( _mutex );
+				while( int( _cache.size() ) > _capacity ){
+
+					_cache.erase( _recent.back() );
+					_recent.pop_back();
+
+				}
+
+			}catch( ... ){
+
+				if( !data.empty() ) unlink( entry->filename.c_str() );
+				loading.set_exception( std::current_exception() );
+
+				std::lock_guard< std::mutex > lock( _mutex );
+				auto found = _cache.find( key );
+				if( found != _cache.end() && found->second == entry ){
+
+					_cache.erase( found );
+					_recent.remove( key );
+
+				}
+
+				throw;
+
+			}
+
+			return entry;
+
+		}
+
+		// Cached, or being loaded by another request (rethrows its error, if any)
+		std::shared_ptr< Job > job = entry->job.get();
+
+		std::lock_guard< std::mutex > lock( _mutex );
+
+		if( job->problem()->plan().full_neighbours || L <= entry->L ){
+
+			cached = true;
+			entry->hits++;
+			return entry;
+
+		}
+
+		// Neighbour lists too short for the L requested: loaded again
+		auto found = _cache.find( key );
+		if( found != _cache.end() && found->second == entry ){
+
+			_cache.erase( found );
+			_recent.remove( key );
+
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Output generation: none (results are replied to each request)
+void Service::generate_output( int g ){}
+////////////////////////////////////////////////////////////////////////////////
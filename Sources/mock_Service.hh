@@ -0,0 +1,146 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+
+#ifndef __MOCK_SERVICE_HH__
+#define __MOCK_SERVICE_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_Service.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Algorithm.hh"
+#include "mock_Job.hh"
+#include "mock_ThreadPool.hh"
+#include <csignal>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+
+/******************
+Class definition
+******************/
+
+// Service mode: clustering requests served over HTTP on a Unix socket or a localhost TCP port 
+// (--serve), --jobs of them at a time
+//	POST /cluster	options of the run, one per line (e.g. "--file data/spiral.data", "--seed 3"); 
+//					the data set is a data file (--file) or given inline (a line "--data" followed 
+//					by the contents of a data file). Reply: rank-1 solutions of the final population
+//					(objective values, number of clusters, ARI and labels), as JSON
+//	GET /status		cached data sets and number of requests, as JSON
+// The data and pre-computations (distance matrix, nearest neighbours, MST) of the --cache data 
+// sets most recently requested are kept: each request for one of them is a Job sharing them 
+// (see ClusteringProblem::share), so only its search remains to be done
+// Errors of a request are replied to (status 400), the service goes on
+class Service : public Algorithm {
+
+	/******************
+	Types
+	******************/
+
+	protected:
+
+		typedef vector< std::pair< string, string > > Parameters;
+
+		// Data set loaded and pre-computed (by a job of its own, shared by the requests)
+		struct Entry{
+
+			std::shared_future< std::shared_ptr< Job > > job;	// Ready once pre-computed
+			string dataset;					// Data file, or "inline"
+			string filename;				// File read (temporary file if inline)
+			int L;							// Length of its neighbour lists, if not complete (L+1)
+			unsigned long hits;				// Requests served from the cache
+
+		};
+
+		typedef std::shared_ptr< Entry > EntryPtr;
+
+	/******************
+	Attributes
+	******************/
+
+	protected:
+
+		string _address;					// Socket address: unix:<path>, or tcp:<port> (localhost)
+
+		int _jobs;							// Number of requests at a time (0: all cores)
+
+		int _capacity;						// Number of data sets kept pre-computed
+
+		Parameters _common;					// Parameters common to all requests (command line)
+
+		std::mutex _mutex;					// Cache and counters
+
+		std::map< string, EntryPtr > _cache;	// Pre-computed data sets (by data set and normalisation)
+
+		std::list< string > _recent;		// Keys of the cached data sets, most recently used first
+
+		unsigned long _requests;			// Number of requests served (and from the cache)
+		unsigned long _hits;
+
+		static volatile std::sig_atomic_t _stop;	// Termination requested (SIGINT, SIGTERM)?
+
+	/******************
+	Methods
+	******************/
+
+	protected:
+
+		// Method configuration
+		virtual void initialise();
+		virtual void configure();	
+
+		// A connection: reads one request and replies
+		void serve( int fd );
+
+		// Requests (reply as JSON, and status code)
+		string cluster( const string & body, int & status );
+		string status();
+
+		// Pre-computed data set (loaded on first request; the least recently used is evicted)
+		EntryPtr acquire( const string & key, const Parameters & parameters, const string & filename, const string & data, int L, bool & cached );
+
+		static void terminate( int signal );
+
+	public:
+
+		// Constructor / destructor
+		Service();
+		virtual ~Service();
+
+		// Service mode requested? (--serve)
+		static bool enabled();
+
+		// Main execution routine (until SIGINT or SIGTERM is received)
+		virtual void run();
+
+		// Output generation (none: results are replied to each request)
+		virtual void generate_output( int g = -1 );
+
+};
+
+#endif
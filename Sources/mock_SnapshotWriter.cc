@@ -0,0 +1,99 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_SnapshotWriter.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+SnapshotWriter::SnapshotWriter( std::function< SolutionPtr() > create, int max_pending ) :
+
+	_max_pending( max_pending ),
+	_stop( false ),
+	_create( create ),
+	_context( Context::current() )
+
+{
+
+	_thread = std::thread( &SnapshotWriter::writer_loop, this );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+// Pending snapshots are written before the writer is stopped
+SnapshotWriter::~SnapshotWriter(){
+
+	{
+		std::lock_guard< std::mutex > lock( _mutex );
+		_stop = true;
+	}
+	_available.notify_all();
+
+	_thread.join();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Queue a snapshot (waits while the queue is full)
+void SnapshotWriter::submit( string prefix, ParetoArchivePtr front ){
+
+	{
+		std::unique_lock< std::mutex > lock( _mutex );
+		_space.wait( lock, [ this ]{ return int( _queue.size() ) < _max_pending; } );
+		_queue.push_back( std::make_pair( prefix, front ) );
+	}
+	_available.notify_one();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Writer thread: decode and write snapshots in order of submission (serially, so that
+// the search keeps the remaining cores)
+void SnapshotWriter::writer_loop(){
+
+	Context::Scope scope( _context, false );
+
+	while( true ){
+
+		std::pair< string, ParetoArchivePtr > snapshot;
+
+		{
+			std::unique_lock< std::mutex > lock( _mutex );
+			_available.wait( lock, [ this ]{ return _stop || !_queue.empty(); } );
+			if( _queue.empty() ) return;
+			snapshot = _queue.front();
+			_queue.pop_front();
+		}
+		_space.notify_one();
+
+		vector< SolutionPtr > solutions;
+		snapshot.second->members( solutions, _create );
+		OutputWriter::write( solutions, snapshot.first, true, 1 );
+
+		// Free memory
+		for( int i = 0; i < int( solutions.size() ); i++ ) delete solutions[ i ];
+		delete snapshot.second;
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
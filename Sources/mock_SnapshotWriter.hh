@@ -0,0 +1,95 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_SNAPSHOTWRITER_HH__
+#define __MOCK_SNAPSHOTWRITER_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_SnapshotWriter.fwd.hh"
+#include "mock_Global.hh"
+#include "mock_Archive.hh"
+#include "mock_OutputWriter.hh"
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+/******************
+Class definition
+******************/
+
+// Background writer of intermediate results (--frequency)
+// The search hands over snapshots of its rank-1 front (objective values and compact genotypes,
+// see ParetoArchive), which are decoded and written by a separate thread, so that reporting does
+// not block the search. At most a few snapshots are queued: if the writer falls behind, the
+// search waits instead of accumulating copies of the front. Pending snapshots are written on destruction
+class SnapshotWriter{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		std::thread _thread;									// Writer thread
+
+		std::deque< std::pair< string, ParetoArchivePtr > > _queue;	// Pending snapshots (output prefix, front)
+
+		std::mutex _mutex;										// Guards queue and flag
+
+		std::condition_variable _available;						// Signalled when a snapshot is queued (or on shutdown)
+
+		std::condition_variable _space;							// Signalled when a snapshot has been taken from the queue
+
+		int _max_pending;										// Maximum number of queued snapshots
+
+		bool _stop;												// Shutdown flag
+
+		std::function< SolutionPtr() > _create;					// Creates (empty) solutions of the right representation
+
+		ContextPtr _context;									// Context of the job (bound to the writer thread)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		void writer_loop();
+
+	public:
+
+		// Constructor / destructor
+		SnapshotWriter( std::function< SolutionPtr() > create, int max_pending = 2 );
+		~SnapshotWriter();
+
+		// Queue a snapshot, written as <prefix>_final_rank1_measures.txt, etc. (the writer takes ownership)
+		void submit( string prefix, ParetoArchivePtr front );
+
+};
+
+#endif
@@ -58,6 +58,11 @@ class Solution{
 
 		double _crowding_distance;		// Crowding distance measure used by NSGA-II
 
+		int * _rank_ref;				// Actual location of rank and crowding distance
+		double * _crowding_ref;			// (own attributes above, or rows of a PopulationStore)
+
+		bool _view;						// Encoding, objectives, rank and crowding owned by a PopulationStore?
+
 	/******************
 	Methods
 	******************/
@@ -71,10 +76,20 @@ class Solution{
 			_kclusters( 0 ), 
 			_evaluation( 0 ),
 			_rank( 0 ),
-			_crowding_distance( 0 )
+			_crowding_distance( 0 ),
+			_rank_ref( &_rank ),
+			_crowding_ref( &_crowding_distance ),
+			_view( false )
 		{ /* do nothing */ }
 		virtual ~Solution(){ /* do nothing */ }
 
+		// Raw genotype (row-based variation operators)
+		VectorIntPtr genes() const { return _encoding; }
+
+		// Moves encoding, objectives, rank and crowding to the given (external) storage
+		void attach( VectorIntPtr enc, VectorDoublePtr obj, int * rank, double * crowding );
+		bool view() const { return _view; }
+
 		// Read/write accesors to solution atributes
     	virtual int & operator[]( const int pos ) const = 0;
 		virtual int & encoding( const int pos ) const = 0;
@@ -93,6 +108,30 @@ class Solution{
 
 }; 
 
+////////////////////////////////////////////////////////////////////////////////
+// The solution becomes a view of the given storage: current values are copied,
+// own memory is released (and not deallocated again on destruction)
+inline void Solution::attach( VectorIntPtr enc, VectorDoublePtr obj, int * rank, double * crowding ){
+
+	for( int i = 0; i < encoding_length(); i++ ) enc[ i ] = _encoding[ i ];
+	for( int m = 0; m < num_objectives; m++ ) obj[ m ] = _objective[ m ];
+	*rank = *_rank_ref;
+	*crowding = *_crowding_ref;
+
+	if( !_view ){
+
+		deallocate_VectorInt( _encoding );
+		deallocate_VectorDouble( _objective );
+
+	}
+
+	_encoding = enc;
+	_objective = obj;
+	_rank_ref = rank;
+	_crowding_ref = crowding;
+	_view = true;
+
+}
 ////////////////////////////////////////////////////////////////////////////////
 
 /******************
@@ -143,8 +182,8 @@ class SolutionCommon : public Solution {
 template < typename SolutionType >
 inline SolutionCommon< SolutionType >::SolutionCommon( bool initialise ){
 
-	_encoding = allocate_VectorInt( encoding_length() );
-	_objective = allocate_VectorDouble( num_objectives );
+	_encoding = allocate_VectorInt( encoding_length(), "solutions" );
+	_objective = allocate_VectorDouble( num_objectives, "solutions" );
 
 	// Initialise: randomly choose a valid value for each encoding position
 	if( initialise ){
@@ -170,8 +209,8 @@ inline SolutionCommon< SolutionType >::SolutionCommon( VectorIntPtr enc, bool cr
 	if( create_new ){ 
 
 		// Allocate memory
-		_encoding = allocate_VectorInt( encoding_length() );
-		_objective = allocate_VectorDouble( num_objectives );
+		_encoding = allocate_VectorInt( encoding_length(), "solutions" );
+		_objective = allocate_VectorDouble( num_objectives, "solutions" );
 
 		// Initialise encoding based on the given one
 		for( int i = 0; i < encoding_length(); i++ ){ 
@@ -183,7 +222,7 @@ inline SolutionCommon< SolutionType >::SolutionCommon( VectorIntPtr enc, bool cr
 	}else{
 
 			// Allocate memory	
-		_objective = allocate_VectorDouble( num_objectives );
+		_objective = allocate_VectorDouble( num_objectives, "solutions" );
 
 		// Assign given pointer
 		_encoding = enc;
@@ -196,9 +235,13 @@ inline SolutionCommon< SolutionType >::SolutionCommon( VectorIntPtr enc, bool cr
 template < typename SolutionType >
 inline SolutionCommon< SolutionType >::~SolutionCommon(){
 
-	// Deallocate memory
-	deallocate_VectorInt( _encoding );
-	deallocate_VectorDouble( _objective );
+	// Deallocate memory (unless owned by a PopulationStore)
+	if( !_view ){
+
+		deallocate_VectorInt( _encoding );
+		deallocate_VectorDouble( _objective );
+
+	}
 	
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -254,7 +297,7 @@ inline unsigned long int & SolutionCommon< SolutionType >::evaluation(){
 template < typename SolutionType >
 inline int & SolutionCommon< SolutionType >::rank(){
 
-	return _rank;
+	return *_rank_ref;
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -262,7 +305,7 @@ inline int & SolutionCommon< SolutionType >::rank(){
 template < typename SolutionType >
 inline double & SolutionCommon< SolutionType >::crowding_distance(){
 
-	return _crowding_distance;
+	return *_crowding_ref;
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +51,7 @@ SolutionSplit::SolutionSplit( SolutionLocus const & locus ) :
 ClusteringPtr SolutionSplit::decode_clustering(){
 
 	// Re-construct full encoding from MST 
-	VectorIntPtr full_encoding = allocate_VectorInt( PROBLEM->ndata() );
+	VectorIntPtr full_encoding = allocate_VectorInt( PROBLEM->ndata(), "clustering" );
 	for( int i = 0; i < PROBLEM->ndata(); i++ ){ 
 
 		full_encoding[ i ] = PROBLEM->mst_edge( i );
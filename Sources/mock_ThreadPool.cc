@@ -0,0 +1,144 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_ThreadPool.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+ThreadPool::ThreadPool( int threads ) : 
+
+	_pending( 0 ),
+	_stop( false ),
+	_context( Context::current() )
+
+{
+
+	if( threads < 1 ) threads = default_threads();
+
+	// Launch workers
+	for( int i=0; i<threads; i++ ){
+
+		_workers.push_back( std::thread( &ThreadPool::worker_loop, this, i ) );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+// Pending tasks are completed before workers are stopped
+ThreadPool::~ThreadPool(){
+
+	wait();
+
+	{
+		std::lock_guard< std::mutex > lock( _mutex );
+		_stop = true;
+	}
+	_available.notify_all();
+
+	for( int i=0; i<size(); i++ ) _workers[ i ].join();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Main routine of each worker: take tasks from the queue until shutdown
+void ThreadPool::worker_loop( int worker ){
+
+	Context::Scope scope( _context, false );
+
+	while( true ){
+
+		std::function< void( int ) > task;
+
+		{
+			std::unique_lock< std::mutex > lock( _mutex );
+			_available.wait( lock, [ this ]{ return _stop || !_tasks.empty(); } );
+
+			if( _stop && _tasks.empty() ) return;
+
+			task = std::move( _tasks.front() );
+			_tasks.pop_front();
+		}
+
+		task( worker );
+
+		{
+			std::lock_guard< std::mutex > lock( _mutex );
+			if( --_pending == 0 ) _finished.notify_all();
+		}
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Queue a task
+void ThreadPool::submit( std::function< void( int ) > task ){
+
+	{
+		std::lock_guard< std::mutex > lock( _mutex );
+		_tasks.push_back( std::move( task ) );
+		_pending++;
+	}
+	_available.notify_one();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Block until all submitted tasks have been completed
+void ThreadPool::wait(){
+
+	std::unique_lock< std::mutex > lock( _mutex );
+	_finished.wait( lock, [ this ]{ return _pending == 0; } );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Apply body( i, worker ) for all i in [0, n), in contiguous chunks (one per worker)
+void ThreadPool::parallel_for( int n, std::function< void( int, int ) > body ){
+
+	int chunks = min( n, size() );
+
+	for( int c=0; c<chunks; c++ ){
+
+		int first = int( ( long( n ) * c ) / chunks );
+		int last = int( ( long( n ) * (c+1) ) / chunks );
+
+		submit( [ first, last, &body ]( int worker ){
+
+			for( int i=first; i<last; i++ ) body( i, worker );
+
+		});
+
+	}
+
+	wait();
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Number of threads to use by default (hardware concurrency, at least one)
+int ThreadPool::default_threads(){
+
+	int threads = int( std::thread::hardware_concurrency() );
+	return ( threads > 0 ) ? threads : 1;
+
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,102 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_THREADPOOL_HH__
+#define __MOCK_THREADPOOL_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock_ThreadPool.fwd.hh"
+#include "mock_Global.hh"
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+/******************
+Class definition
+******************/
+
+// Fixed-size pool of worker threads consuming a FIFO queue of tasks
+// Each task receives the index of the worker executing it, so that tasks can use
+// per-worker resources (e.g. one evaluator object per worker)
+// Workers run in the context of the thread creating the pool (its generator is not shared)
+class ThreadPool{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		vector< std::thread > _workers;						// Worker threads
+
+		std::deque< std::function< void( int ) > > _tasks;	// Queue of pending tasks
+
+		std::mutex _mutex;									// Guards task queue and counters
+
+		std::condition_variable _available;					// Signalled when tasks are queued (or on shutdown)
+
+		std::condition_variable _finished;					// Signalled when all tasks have been completed
+
+		int _pending;										// Number of queued or running tasks
+
+		bool _stop;											// Shutdown flag
+
+		ContextPtr _context;								// Context of the job (bound to the workers)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		void worker_loop( int worker );
+
+	public:
+
+		// Constructor / destructor
+		ThreadPool( int threads );
+		~ThreadPool();
+
+		// Number of worker threads
+		int size(){ return int( _workers.size() ); }
+
+		// Queue a task (receives the index of the worker executing it)
+		void submit( std::function< void( int ) > task );
+
+		// Block until all submitted tasks have been completed
+		void wait();
+
+		// Apply body( i, worker ) for i in [0, n) and wait for completion
+		void parallel_for( int n, std::function< void( int, int ) > body );
+
+		// Number of threads to use when none (or a non-positive value) is requested
+		static int default_threads();
+
+};
+
+#endif
@@ -134,87 +134,23 @@ Last updated: 10 July 2017
 // }
 ////////////////////////////////////////////////////////////////////////////////
 // Neighbourhood-biased mutation (original, full-length locus encoding)
-// Mutation occurs at each encoding position with a probability which depends on its current value
 void UnaryOperator::neighbourhood_biased_mutation( SolutionPtr const sol, double prob ){
 
-	// Given 'prob' defines the total number of alleles expected to mutate
-	// Compute mutation probability as "prob / encoding_length"
-	prob = prob / sol->encoding_length();
-
-	// Mutate each allele
-	for( int i = 0; i < sol->encoding_length(); i++ ){
-
-		// Adjust mutation probability based on ranking of current link
-		double rank = PROBLEM->neighbour_rank( i, (*sol)[ i ] );
-		double allele_prob = prob + pow( rank / sol->encoding_length(), 2 );
-
-		if( random_real(0, 1) < allele_prob ){
-
-			// Replace allele with a randomly selected alternative
-			(*sol)[ i ] = sol->random_encoding( i, (*sol)[ i ] );
-
-		}
-
-	}
+	neighbourhood_biased_mutation< SolutionLocus >( sol->genes(), prob );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Neighbourhood-biased mutation (short locus encoding)
-// Mutation occurs at each encoding position with a probability which depends on its current value
 void UnaryOperator::neighbourhood_biased_mutation_short( SolutionPtr const sol, double prob ){
 
-	// Given 'prob' defines the total number of alleles expected to mutate
-	// Compute mutation probability as "prob / encoding_length"
-	prob = prob / sol->encoding_length();
-
-	// Mutate each allele
-	for( int i = 0; i < sol->encoding_length(); i++ ){
-
-		// Adjust mutation probability based on ranking of current link
-		double rank = PROBLEM->neighbour_rank( PROBLEM->relevant_edge(i), (*sol)[ i ] );
-		double allele_prob = prob + pow( rank / sol->encoding_length(), 2 );
-
-		if( random_real(0, 1) < allele_prob ){
-
-			// Replace allele with a randomly selected alternative
-			(*sol)[ i ] = sol->random_encoding( i, (*sol)[ i ] );
-
-		}
-
-	}
+	neighbourhood_biased_mutation< SolutionShort >( sol->genes(), prob );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Neighbourhood-biased mutation (short binary encoding)
-// Mutation occurs at each encoding position with a probability which depends on its current value
 void UnaryOperator::neighbourhood_biased_mutation_split( SolutionPtr const sol, double prob ){
 
-	// Given 'prob' defines the total number of alleles expected to mutate
-	// Compute mutation probability as "prob / encoding_length"
-	prob = prob / sol->encoding_length();
-
-	// Mutate each allele
-	for( int i = 0; i < sol->encoding_length(); i++ ){
-
-		double allele_prob = prob;
-
-		// Adjust mutation probability based on ranking of current link
-		if( (*sol)[ i ] == 1 ){
-			int edge = PROBLEM->relevant_edge(i);
-			double rank = PROBLEM->neighbour_rank( edge, PROBLEM->mst_edge(edge) );
-			allele_prob += pow( rank / sol->encoding_length(), 2 );
-		}
-
-		if( random_real(0, 1) < allele_prob ){
-
-			// Replace allele with a randomly selected alternative
-			(*sol)[ i ] = sol->random_encoding( i, (*sol)[ i ] );
-
-		}
-
-	}
+	neighbourhood_biased_mutation< SolutionSplit >( sol->genes(), prob );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
-
-
@@ -31,6 +31,38 @@ Dependencies
 ******************/
 #include "mock_Global.hh"
 #include "mock_Solution.hh"
+#include "mock_SolutionLocus.hh"
+#include "mock_SolutionShort.hh"
+#include "mock_SolutionSplit.hh"
+
+/******************
+Class definition
+******************/
+
+// Precomputed probabilities of the neighbourhood-biased mutation for a given representation
+// The probability of mutating position i is prob + extra(i), where extra(i) depends on the rank 
+// of the link encoded at i. This is sampled as the union of two independent events: a base event
+// (rate prob, sampled by geometric skips over the genotype) and an extra event of probability
+// extra(i) / (1 - prob). Alleles are either MST links or links to one of the L+1 nearest 
+// neighbours, so extra events are sampled by thinning: candidate positions are drawn at the
+// maximum rate of those links and accepted with the ratio of the actual rate to this bound.
+// Positions whose MST link is ranked beyond L+1 are few, and are checked individually
+struct MutationTable{
+
+	double prob;						// Base probability (cache key, with length and problem)
+	int length;
+	uint64_t problem;					// (ClusteringProblem::instance)
+
+	double log_base;					// log( 1 - prob ), for geometric skips
+	double bound;						// Rate of candidate positions (extra events)
+	double log_bound;					// log( 1 - bound )
+
+	vector< double > by_rank;			// Extra event probability by link rank (0..L+1)
+	vector< double > by_position;		// Extra event probability by position (split representation)
+	vector< char > regular;				// Position covered by the candidate bound?
+	vector< int > irregular;			// Positions checked individually (ascending)
+
+};
 
 /******************
 Class definition
@@ -65,10 +97,256 @@ class UnaryOperator{
 		static void neighbourhood_biased_mutation_short( SolutionPtr const sol, double prob );
 		static void neighbourhood_biased_mutation_split( SolutionPtr const sol, double prob );
 
+		// Row-based kernels (used directly by the representation-typed pipeline)
+		template < typename SolutionType >
+		static void neighbourhood_biased_mutation( int * genes, double prob );
+
+	private:
+
+		// Precomputed probabilities (built once per thread, representation and probability)
+		template < typename SolutionType >
+		static const MutationTable & mutation_table( double prob );
+
+		template < typename SolutionType >
+		static int position_node( int i );
+
+		template < typename SolutionType >
+		static int link_rank( int i, int allele );
+
+		template < typename SolutionType >
+		static double extra_probability( const MutationTable & table, int i, int allele );
+
+		static int next_position( int i, double rate, double log_rate );
+
 		// static void relevant_edge_mutation( SolutionPtr const sol, double prob );
 		// static void krepair_uniform_mutation( SolutionPtr const sol, double prob );
 
 };
 
-#endif
+////////////////////////////////////////////////////////////////////////////////
+// Data point whose link is encoded at position i
+template < typename SolutionType >
+inline int UnaryOperator::position_node( int i ){
+
+	return PROBLEM->relevant_edge( i );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+template <>
+inline int UnaryOperator::position_node< SolutionLocus >( int i ){
+
+	return i;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Rank of the link encoded by the given allele at position i
+template < typename SolutionType >
+inline int UnaryOperator::link_rank( int i, int allele ){
+
+	return PROBLEM->neighbour_rank( position_node< SolutionType >( i ), allele );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Split representation: rank of the MST link at position i (only "1" alleles are biased)
+template <>
+inline int UnaryOperator::link_rank< SolutionSplit >( int i, int allele ){
+
+	int edge = PROBLEM->relevant_edge( i );
+	return PROBLEM->neighbour_rank( edge, PROBLEM->mst_edge( edge ) );
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Probability of the extra event at position i, given its current allele
+template < typename SolutionType >
+inline double UnaryOperator::extra_probability( const MutationTable & table, int i, int allele ){
+
+	int rank = link_rank< SolutionType >( i, allele );
+	if( rank < int( table.by_rank.size() ) ) return table.by_rank[ rank ];
+
+	double extra = pow( double( rank ) / table.length, 2 ) / ( 1.0 - table.prob );
+	return ( extra < 1.0 ) ? extra : 1.0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+template <>
+inline double UnaryOperator::extra_probability< SolutionSplit >( const MutationTable & table, int i, int allele ){
+
+	return ( allele == 1 ) ? table.by_position[ i ] : 0.0;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Next position (after i) at which an event of the given rate occurs (geometric skip)
+inline int UnaryOperator::next_position( int i, double rate, double log_rate ){
+
+	if( rate >= 1.0 ) return i + 1;
+	if( rate <= 0.0 ) return INT_MAX;
+
+	double skip = floor( log( 1.0 - rnd->uniform() ) / log_rate );
+	return ( skip < double( INT_MAX - 1 - i ) ) ? i + 1 + int( skip ) : INT_MAX;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Precomputed probabilities for the current problem, encoding length and base probability
+template < typename SolutionType >
+inline const MutationTable & UnaryOperator::mutation_table( double prob ){
+
+	static thread_local MutationTable table = { -1.0, 0, 0 };
+
+	const int length = SolutionType::static_encoding_length();
+	if( table.prob == prob && table.length == length && table.problem == PROBLEM->instance() ){
+
+		PROFILE_COUNT( MUTATION_TABLE_HITS, 1 );
+		return table;
+
+	}
+
+	PROFILE_COUNT( MUTATION_TABLE_BUILDS, 1 );
+
+	table.prob = prob;
+	table.length = length;
+	table.problem = PROBLEM->instance();
+	table.log_base = log1p( -prob );
+
+	// Extra event probability, by rank of the encoded link
+	const int max_rank = mock_L + 1;
+	table.by_rank.assign( max_rank + 1, 0.0 );
+	if( prob < 1.0 ){
+
+		for( int r = 0; r <= max_rank; r++ ){
+
+			double extra = pow( double( r ) / length, 2 ) / ( 1.0 - prob );
+			table.by_rank[ r ] = ( extra < 1.0 ) ? extra : 1.0;
+
+		}
 
+	}
+
+	// Positions whose MST link is ranked beyond the nearest neighbours are checked individually
+	table.regular.assign( length, 1 );
+	table.irregular.clear();
+	table.by_position.clear();
+	table.bound = table.by_rank[ max_rank ];
+
+	for( int i = 0; i < length; i++ ){
+
+		if( link_rank< SolutionType >( i, PROBLEM->mst_edge( position_node< SolutionType >( i ) ) ) > max_rank ){
+
+			table.regular[ i ] = 0;
+			table.irregular.push_back( i );
+
+		}
+
+	}
+
+	table.log_bound = log1p( -table.bound );
+
+	return table;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Split representation: the extra probability of each position is fixed by the MST
+template <>
+inline const MutationTable & UnaryOperator::mutation_table< SolutionSplit >( double prob ){
+
+	static thread_local MutationTable table = { -1.0, 0, 0 };
+
+	const int length = SolutionSplit::static_encoding_length();
+	if( table.prob == prob && table.length == length && table.problem == PROBLEM->instance() ){
+
+		PROFILE_COUNT( MUTATION_TABLE_HITS, 1 );
+		return table;
+
+	}
+
+	PROFILE_COUNT( MUTATION_TABLE_BUILDS, 1 );
+
+	table.prob = prob;
+	table.length = length;
+	table.problem = PROBLEM->instance();
+	table.log_base = log1p( -prob );
+
+	const int max_rank = mock_L + 1;
+	table.by_rank.clear();
+	table.by_position.assign( length, 0.0 );
+	table.regular.assign( length, 1 );
+	table.irregular.clear();
+	table.bound = 0.0;
+
+	for( int i = 0; i < length; i++ ){
+
+		int rank = link_rank< SolutionSplit >( i, 1 );
+
+		double extra = ( prob < 1.0 ) ? pow( double( rank ) / length, 2 ) / ( 1.0 - prob ) : 0.0;
+		table.by_position[ i ] = ( extra < 1.0 ) ? extra : 1.0;
+
+		if( rank > max_rank ){
+
+			table.regular[ i ] = 0;
+			table.irregular.push_back( i );
+
+		}else if( table.by_position[ i ] > table.bound ){
+
+			table.bound = table.by_position[ i ];
+
+		}
+
+	}
+
+	table.log_bound = log1p( -table.bound );
+
+	return table;
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Neighbourhood-biased mutation
+// Mutation occurs at each encoding position with a probability which depends on its current value:
+// prob + ( rank / length )^2, where rank is the position of the encoded link in the nearest 
+// neighbour list (split representation: the MST link, only if present)
+// Only the positions drawn by the base and candidate event streams (and irregular positions) are
+// visited, so the cost is proportional to the number of mutations rather than the encoding length
+template < typename SolutionType >
+inline void UnaryOperator::neighbourhood_biased_mutation( int * genes, double prob ){
+
+	// Given 'prob' defines the total number of alleles expected to mutate
+	// Compute mutation probability as "prob / encoding_length"
+	const int length = SolutionType::static_encoding_length();
+	const MutationTable & table = mutation_table< SolutionType >( prob / length );
+
+	int base = next_position( -1, table.prob, table.log_base );
+	int candidate = next_position( -1, table.bound, table.log_bound );
+	int k = 0, irregular = table.irregular.empty() ? INT_MAX : table.irregular[ 0 ];
+
+	while( true ){
+
+		int i = min( base, min( candidate, irregular ) );
+		if( i >= length ) break;
+
+		bool mutate = ( i == base );
+
+		if( i == candidate ){
+
+			// Thinning: accept candidate with the ratio of its actual rate to the bound
+			if( !mutate && table.regular[ i ] && rnd->uniform() * table.bound < extra_probability< SolutionType >( table, i, genes[ i ] ) ) mutate = true;
+			candidate = next_position( i, table.bound, table.log_bound );
+
+		}
+
+		if( i == irregular ){
+
+			if( !mutate && rnd->uniform() < extra_probability< SolutionType >( table, i, genes[ i ] ) ) mutate = true;
+			k++;
+			irregular = ( k < int( table.irregular.size() ) ) ? table.irregular[ k ] : INT_MAX;
+
+		}
+
+		if( i == base ) base = next_position( i, table.prob, table.log_base );
+
+		// Replace allele with a randomly selected alternative
+		if( mutate ) genes[ i ] = SolutionType::static_random_encoding( i, genes[ i ] );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -24,6 +24,9 @@ Last updated: 10 July 2017
 *******************************************************************************/
 
 #include "mock_Util.hh"
+#include "mock_Memory.hh"
+#include "mock_Context.hh"
+#include <stdexcept>
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -40,6 +43,10 @@ void error_message( string msg ){
 void error_message_exit( string msg ){
 	
 	error_message( msg );
+
+	// Errors of a recoverable context (e.g. a service request) end the job, not the process
+	if( Context::current()->recoverable ) throw std::runtime_error( msg );
+
 	exit( 1 );
 
 }
@@ -114,29 +121,103 @@ double min( double a, double b ){
 
     return ( a < b ) ? a : b;
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Header preceding each tracked block: size, owner tag and offset from the start of the
+// underlying allocation (PROFILE_LEVEL > 0; otherwise blocks are not tracked)
+struct BlockHeader{
+
+    uint64_t bytes;
+    int32_t tag;
+    int32_t offset;
+
+};
+static_assert( sizeof( BlockHeader ) == 16, "BlockHeader must preserve 16-byte alignment" );
+
+////////////////////////////////////////////////////////////////////////////////
+// Allocates a block of the given size (bytes), owned by the given tag, starting at a multiple
+// of the given alignment (bytes, power of two; 0: default alignment), and returns pointer
+// Exits with the per-tag memory usage if the allocation fails
+void * allocate_tracked( size_t bytes, const char * tag, size_t alignment ){
+
+    #if PROFILE_LEVEL > 0
+        const size_t offset = max( alignment, sizeof( BlockHeader ) );
+    #else
+        const size_t offset = 0;
+    #endif
+
+    // Overflow of the size computation (e.g. negative sizes converted to size_t)
+    void * base = nullptr;
+    if( bytes <= SIZE_MAX - offset - alignment ){
+
+        if( alignment > 0 ){
+
+            if( posix_memalign( &base, alignment, offset + max( bytes, size_t( 1 ) ) ) != 0 ) base = nullptr;
+
+        }else{
+
+            base = malloc( offset + max( bytes, size_t( 1 ) ) );
+
+        }
+
+    }
+
+    if( base == nullptr ){
+
+        error_message_exit( "Memory allocation failed (" + to_string( bytes ) + " bytes, " + tag + ")\n" + Memory::summary() );
+
+    }
+
+    #if PROFILE_LEVEL > 0
+        char * block = static_cast< char * >( base ) + offset;
+        BlockHeader * header = reinterpret_cast< BlockHeader * >( block ) - 1;
+        header->bytes = bytes;
+        header->tag = Memory::tag( tag );
+        header->offset = int32_t( offset );
+        Memory::allocated( header->tag, bytes );
+        return block;
+    #else
+        return base;
+    #endif
+
+}
+////////////////////////////////////////////////////////////////////////////////
+// Frees the given tracked block
+void deallocate_tracked( void * block ){
+
+    if( block == nullptr ) return;
+
+    #if PROFILE_LEVEL > 0
+        BlockHeader * header = static_cast< BlockHeader * >( block ) - 1;
+        Memory::released( header->tag, header->bytes );
+        free( static_cast< char * >( block ) - header->offset );
+    #else
+        free( block );
+    #endif
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Allocates memory for a float-type array of given size, and returns pointer
-VectorFloatPtr allocate_VectorFloat( int size ){
+VectorFloatPtr allocate_VectorFloat( size_t size, const char * tag ){
 
-    return VectorFloatPtr( new float [ size ] );
+    return VectorFloatPtr( allocate_tracked( size * sizeof( float ), tag ) );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Frees memory of the given float-type vector
 void deallocate_VectorFloat( VectorFloatPtr vector ){
 
-    delete[] vector;
+    deallocate_tracked( vector );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Allocates memory for a float-type matrix of given size, and returns pointer
-MatrixFloatPtr allocate_MatrixFloat( int rows, int cols ){
+MatrixFloatPtr allocate_MatrixFloat( int rows, int cols, const char * tag ){
 
-    MatrixFloatPtr matrix = MatrixFloatPtr( new VectorFloatPtr [ rows ] );
+    MatrixFloatPtr matrix = MatrixFloatPtr( allocate_tracked( size_t( rows ) * sizeof( VectorFloatPtr ), tag ) );
 
     for( int i=0; i<rows; i++ ) 
-        matrix[ i ] = allocate_VectorFloat( cols );
+        matrix[ i ] = allocate_VectorFloat( cols, tag );
 
     return matrix;
 
@@ -145,34 +226,36 @@ MatrixFloatPtr allocate_MatrixFloat( int rows, int cols ){
 // Frees memory of the given float-type matrix
 void deallocate_MatrixFloat( MatrixFloatPtr matrix, int rows ){
 
+    if( matrix == nullptr ) return;
+
     for( int i=0; i<rows; i++ ) 
         deallocate_VectorFloat( matrix[ i ] );
 
-    delete[] matrix;
+    deallocate_tracked( matrix );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Allocates memory for a int-type array of given size, and returns pointer
-VectorIntPtr allocate_VectorInt( int size ){
+VectorIntPtr allocate_VectorInt( size_t size, const char * tag ){
 
-    return VectorIntPtr( new int [ size ] );
+    return VectorIntPtr( allocate_tracked( size * sizeof( int ), tag ) );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Frees memory of the given int-type vector
 void deallocate_VectorInt( VectorIntPtr vector ){
 
-    delete[] vector;
+    deallocate_tracked( vector );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Allocates memory for a int-type matrix of given size, and returns pointer
-MatrixIntPtr allocate_MatrixInt( int rows, int cols ){
+MatrixIntPtr allocate_MatrixInt( int rows, int cols, const char * tag ){
 
-    MatrixIntPtr matrix = MatrixIntPtr( new VectorIntPtr [ rows ] );
+    MatrixIntPtr matrix = MatrixIntPtr( allocate_tracked( size_t( rows ) * sizeof( VectorIntPtr ), tag ) );
 
     for( int i=0; i<rows; i++ ) 
-        matrix[ i ] = allocate_VectorInt( cols );
+        matrix[ i ] = allocate_VectorInt( cols, tag );
 
     return matrix;
 
@@ -181,56 +264,51 @@ MatrixIntPtr allocate_MatrixInt( int rows, int cols ){
 // Frees memory of the given int-type matrix
 void deallocate_MatrixInt( MatrixIntPtr matrix, int rows ){
 
+    if( matrix == nullptr ) return;
+
     for( int i=0; i<rows; i++ ) 
         deallocate_VectorInt( matrix[ i ] );
 
-    delete[] matrix;
+    deallocate_tracked( matrix );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
-// Allocates memory for a double-type array of given size, and returns pointer
-VectorDoublePtr allocate_VectorDouble( int size ){
-
-    VectorDoublePtr x;
-    try{
-
-        x = new double [ size ];
+// Allocates memory for a int-type array of given size, starting at a multiple of the
+// given alignment (bytes, power of two), and returns pointer
+VectorIntPtr allocate_aligned_VectorInt( size_t size, size_t alignment, const char * tag ){
 
-    }catch( std::bad_alloc & ba ) {
-
-        std::cerr << "bad_alloc caught: " << ba.what() << '\n';
-        exit(1);
-
-    }
+    return VectorIntPtr( allocate_tracked( size * sizeof( int ), tag, alignment ) );
 
+}
+////////////////////////////////////////////////////////////////////////////////
+// Frees memory of the given aligned int-type vector
+void deallocate_aligned_VectorInt( VectorIntPtr vector ){
 
-    // // VectorDoublePtr x = VectorDoublePtr( new double [ size ] );
-    //  = new (nothrow) double [ size ];
-    // if(x == nullptr){
-    //     cout << "Problem when allocating memory!!!" << endl;
- 
-    //     exit(0);
+    deallocate_tracked( vector );
 
-    // }
+}
+////////////////////////////////////////////////////////////////////////////////
+// Allocates memory for a double-type array of given size, and returns pointer
+VectorDoublePtr allocate_VectorDouble( size_t size, const char * tag ){
 
-    return x;
+    return VectorDoublePtr( allocate_tracked( size * sizeof( double ), tag ) );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Frees memory of the given double-type vector
 void deallocate_VectorDouble( VectorDoublePtr vector ){
 
-    delete[] vector;
+    deallocate_tracked( vector );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Allocates memory for a double-type matrix of given size, and returns pointer
-MatrixDoublePtr allocate_MatrixDouble( int rows, int cols ){
+MatrixDoublePtr allocate_MatrixDouble( int rows, int cols, const char * tag ){
 
-    MatrixDoublePtr matrix = MatrixDoublePtr( new VectorDoublePtr [ rows ] );
+    MatrixDoublePtr matrix = MatrixDoublePtr( allocate_tracked( size_t( rows ) * sizeof( VectorDoublePtr ), tag ) );
 
     for( int i=0; i<rows; i++ ) 
-        matrix[ i ] = allocate_VectorDouble( cols );
+        matrix[ i ] = allocate_VectorDouble( cols, tag );
 
     return matrix;
 
@@ -239,10 +317,12 @@ MatrixDoublePtr allocate_MatrixDouble( int rows, int cols ){
 // Frees memory of the given double-type matrix
 void deallocate_MatrixDouble( MatrixDoublePtr matrix, int rows ){
 
+    if( matrix == nullptr ) return;
+
     for( int i=0; i<rows; i++ ) 
         deallocate_VectorDouble( matrix[ i ] );
 
-    delete[] matrix;
+    deallocate_tracked( matrix );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,8 +379,9 @@ void initialise_random( unsigned long int seed ){
         seed = std::chrono::system_clock::now().time_since_epoch().count();
     }
 
-    // Instantiate generator
-    rnd = new default_random_engine( seed );
+    // Instantiate generator (main generator of the current context)
+    rnd = RandomPtr( new Random( seed ) );
+    Context::current()->random = rnd;
 
     // Some examples:
     random_int(0, 10);      // produces integer in [0,10]
@@ -312,15 +393,14 @@ void initialise_random( unsigned long int seed ){
 // Real random numbers within range [min, max)
 double random_real( double min, double max ){
 
-    uniform_real_distribution< double > distribution( min, max );
-    return distribution( *rnd );
+    return min + ( max - min ) * rnd->uniform();
+
 }
 ////////////////////////////////////////////////////////////////////////////////
 // Integer random numbers within range [min, max]
 int random_int( int min, int max ){
 
-    uniform_int_distribution< int > distribution( min , max );
-    return distribution( *rnd );
+    return rnd->uniform_int( min, max );
 
 }
 ////////////////////////////////////////////////////////////////////////////////
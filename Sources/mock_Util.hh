@@ -49,22 +49,28 @@ double max( double a, double b );
 int min( int a, int b );
 double min( double a, double b );
 
+// Tracked allocation/deallocation of raw blocks (bytes in use per owner tag, see mock_Memory.hh)
+void * allocate_tracked( size_t bytes, const char * tag = "other", size_t alignment = 0 );
+void deallocate_tracked( void * block );
+
 // Allocation/deallocation of float-type vectors and matrices
-VectorFloatPtr allocate_VectorFloat( int size );
+VectorFloatPtr allocate_VectorFloat( size_t size, const char * tag = "other" );
 void deallocate_VectorFloat( VectorFloatPtr vector );
-MatrixFloatPtr allocate_MatrixFloat( int rows, int cols );
+MatrixFloatPtr allocate_MatrixFloat( int rows, int cols, const char * tag = "other" );
 void deallocate_MatrixFloat( MatrixFloatPtr matrix, int rows );
 
 // Allocation/deallocation of int-type vectors and matrices
-VectorIntPtr allocate_VectorInt( int size );
+VectorIntPtr allocate_VectorInt( size_t size, const char * tag = "other" );
 void deallocate_VectorInt( VectorIntPtr vector );
-MatrixIntPtr allocate_MatrixInt( int rows, int cols );
+MatrixIntPtr allocate_MatrixInt( int rows, int cols, const char * tag = "other" );
 void deallocate_MatrixInt( MatrixIntPtr matrix, int rows );
+VectorIntPtr allocate_aligned_VectorInt( size_t size, size_t alignment = 64, const char * tag = "other" );
+void deallocate_aligned_VectorInt( VectorIntPtr vector );
 
 // Allocation/deallocation of double-type vectors and matrices
-VectorDoublePtr allocate_VectorDouble( int size );
+VectorDoublePtr allocate_VectorDouble( size_t size, const char * tag = "other" );
 void deallocate_VectorDouble( VectorDoublePtr vector );
-MatrixDoublePtr allocate_MatrixDouble( int rows, int cols );
+MatrixDoublePtr allocate_MatrixDouble( int rows, int cols, const char * tag = "other" );
 void deallocate_MatrixDouble( MatrixDoublePtr matrix, int rows );
 
 // Array operations
@@ -0,0 +1,492 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#include "mock_bench.hh"
+
+////////////////////////////////////////////////////////////////////
+// Benchmark driver: kernels and end-to-end runs on each data set
+int main( int argc, char *argv[] ){
+
+	// Settings
+	vector< string > files, kernels;
+	string suite = "standard", output = "bench_results.jsonl", delta = "80", normalise = "true", threads = "1";
+	unsigned long int seed = 0;
+	int repetitions = 10, warmup = 2, population_size = 100, generations = 20;
+	double min_time = 0.05;
+
+	for( int i = 1; i < argc; i++ ){
+
+		string option = argv[ i ];
+
+		if( option == "--help" || option == "-h" ){
+
+			show_bench_usage( string( argv[0] ) );
+			return 0;
+
+		}
+
+		if( i + 1 >= argc ){
+
+			show_bench_usage( string( argv[0] ) );
+			error_message_exit( "Missing value of command-line option: " + option );
+
+		}
+
+		string value = argv[ ++i ];
+
+		if( option == "--file" ) files.push_back( value );
+		else if( option == "--suite" ) suite = value;
+		else if( option == "--kernels" ){
+
+			std::stringstream list( value );
+			for( string kernel; getline( list, kernel, ',' ); ) if( !kernel.empty() ) kernels.push_back( kernel );
+
+		}
+		else if( option == "--repetitions" ) repetitions = stoi( value );
+		else if( option == "--warmup" ) warmup = stoi( value );
+		else if( option == "--mintime" ) min_time = stod( value );
+		else if( option == "--population" ) population_size = stoi( value );
+		else if( option == "--generations" ) generations = stoi( value );
+		else if( option == "--delta" ) delta = value;
+		else if( option == "--normalise" ) normalise = value;
+		else if( option == "--threads" ) threads = value;
+		else if( option == "--lparameter" ) mock_L = stoi( value );
+		else if( option == "--seed" ) seed = stoul( value );
+		else if( option == "--output" ) output = value;
+		else{
+
+			show_bench_usage( string( argv[0] ) );
+			error_message_exit( "Unrecognised command-line option: " + option );
+
+		}
+
+	}
+
+	if( repetitions < 2 ) error_message_exit( "At least two repetitions are required (--repetitions)" );
+	if( population_size < 4 || population_size % 4 != 0 ) error_message_exit( "Population size needs to be a multiple of 4! (--population)" );
+	if( seed == 0 ) seed = 1;
+
+	// Data sets of the chosen suite (relative to the Sources directory)
+	if( files.empty() ){
+
+		const string synthetic = "../Data sets/synthetic_datasets/", ukc = "../Data sets/UKC_datasets/";
+
+		if( suite == "small" ){
+
+			files = { "data_example/spiral_labels_headers.data", synthetic + "tevc_20_10_1_labels_headers.data" };
+
+		}else if( suite == "standard" ){
+
+			files = { synthetic + "tevc_20_10_1_labels_headers.data", synthetic + "tevc_100_40_1_labels_headers.data", 
+					  synthetic + "tevc_50_100_1_labels_headers.data" };
+
+		}else if( suite == "large" ){
+
+			files = { ukc + "UKC1.txt", ukc + "UKC5.txt" };
+
+		}else{
+
+			error_message_exit( "Unrecognised benchmark suite (--suite): " + suite );
+
+		}
+
+	}
+
+	ofstream out( output );
+	if( !out.is_open() ) error_message_exit( "Cannot write file: " + output );
+
+	for( int f = 0; f < int( files.size() ); f++ ){
+
+		// Settings of the problem and algorithm
+		input_parameters = { { "--file", files[ f ] }, { "--normalise", normalise }, { "--delta", delta },
+							 { "--population", to_string( population_size ) }, { "--generations", to_string( generations ) },
+							 { "--threads", threads } };
+
+		cout << "Data set: " << files[ f ] << endl;
+
+		// Problem instance (data loading and pre-computations)
+		delete rnd;
+		initialise_random( seed );
+		std::streambuf * standard = cout.rdbuf( nullptr );
+		PROBLEM = ClusteringProblemPtr( new ClusteringProblem() );
+		cout.rdbuf( standard );
+		cout.clear();
+
+		Benchmark benchmark( files[ f ], kernels, repetitions, warmup, min_time, population_size, generations, out );
+		benchmark.run_kernels();
+		benchmark.run_end_to_end();
+
+		delete PROBLEM;
+		PROBLEM = nullptr;
+
+	}
+
+	delete rnd;
+
+	cout << "Results: " << output << endl;
+
+	return 0;
+
+}
+////////////////////////////////////////////////////////////////////
+// Constructor
+Benchmark::Benchmark( string dataset, vector< string > kernels, int repetitions, int warmup, double min_time, 
+					  int population_size, int generations, ofstream & out ) :
+
+	_dataset( dataset ),
+	_kernels( kernels ),
+	_repetitions( repetitions ),
+	_warmup( warmup ),
+	_min_time( min_time ),
+	_population_size( population_size ),
+	_generations( generations ),
+	_out( out ),
+	_cout( nullptr )
+
+{
+}
+////////////////////////////////////////////////////////////////////
+// Kernel to be run? (all kernels if none was chosen)
+bool Benchmark::selected( string kernel ){
+
+	return _kernels.empty() || std::find( _kernels.begin(), _kernels.end(), kernel ) != _kernels.end();
+
+}
+////////////////////////////////////////////////////////////////////
+// Measures a kernel: warm-up calls, calibration of the number of calls per measurement 
+// (kernels with a set-up step, run before every call and not timed, are called once per measurement),
+// then _repetitions measurements
+void Benchmark::measure( string kernel, std::function< void() > body, std::function< void() > setup, long items ){
+
+	if( !selected( kernel ) ) return;
+
+	typedef std::chrono::steady_clock clock;
+
+	// Silence progress messages of the measured code
+	_cout = cout.rdbuf( nullptr );
+
+	for( int w = 0; w < _warmup; w++ ){
+
+		if( setup ) setup();
+		body();
+
+	}
+
+	auto timed = [ & ]( long inner ){
+
+		if( setup ) setup();
+		clock::time_point start = clock::now();
+		for( long i = 0; i < inner; i++ ) body();
+		return std::chrono::duration< double >( clock::now() - start ).count();
+
+	};
+
+	long inner = 1;
+	if( !setup ){
+
+		while( inner < ( 1L << 20 ) && timed( inner ) < _min_time ) inner *= 2;
+
+	}
+
+	vector< double > times( _repetitions );
+	for( int r = 0; r < _repetitions; r++ ) times[ r ] = timed( inner ) / inner;
+
+	cout.rdbuf( _cout );
+	cout.clear();
+
+	report( kernel, times, inner, items );
+
+}
+////////////////////////////////////////////////////////////////////
+// Writes the statistics of a kernel (JSON line) and a summary line on the standard output
+void Benchmark::report( string kernel, vector< double > & times, long inner, long items ){
+
+	// Two-sided 95% quantiles of Student's t distribution (degrees of freedom 1..30)
+	static const double t95[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 
+								  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+								  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+	const int n = int( times.size() );
+	std::sort( times.begin(), times.end() );
+
+	double median = ( n % 2 == 1 ) ? times[ n/2 ] : 0.5 * ( times[ n/2 - 1 ] + times[ n/2 ] );
+	double mean = 0.0, variance = 0.0;
+	for( int r = 0; r < n; r++ ) mean += times[ r ];
+	mean /= n;
+	for( int r = 0; r < n; r++ ) variance += ( times[ r ] - mean ) * ( times[ r ] - mean );
+	double stddev = sqrt( variance / ( n - 1 ) );
+	double ci95 = ( ( n - 1 <= 30 ) ? t95[ n - 2 ] : 1.96 ) * stddev / sqrt( double( n ) );
+
+	vector< double > deviations( n );
+	for( int r = 0; r < n; r++ ) deviations[ r ] = fabs( times[ r ] - median );
+	std::sort( deviations.begin(), deviations.end() );
+	double mad = ( n % 2 == 1 ) ? deviations[ n/2 ] : 0.5 * ( deviations[ n/2 - 1 ] + deviations[ n/2 ] );
+
+	// Data set name without quotes or backslashes (JSON string)
+	string dataset = _dataset;
+	std::replace( dataset.begin(), dataset.end(), '"', '\'' );
+	std::replace( dataset.begin(), dataset.end(), '\\', '/' );
+
+	_out.precision( 9 );
+	_out << "{\"dataset\": \"" << dataset << "\", \"ndata\": " << PROBLEM->ndata() << ", \"mdim\": " << PROBLEM->mdim()
+		 << ", \"kernel\": \"" << kernel << "\", \"items\": " << items << ", \"inner\": " << inner << ", \"repetitions\": " << n
+		 << ", \"unit\": \"s\", \"min\": " << times[ 0 ] << ", \"median\": " << median << ", \"mean\": " << mean
+		 << ", \"stddev\": " << stddev << ", \"ci95\": " << ci95 << ", \"mad\": " << mad << ", \"max\": " << times[ n-1 ] << "}" << endl;
+
+	cout << "\t" << kernel << ": " << median << " s (median of " << n << ", +/- " << ci95 << ")" << endl;
+
+}
+////////////////////////////////////////////////////////////////////
+// Population of MST solutions with a random number of removed links (as the initial solutions)
+PopulationPtr Benchmark::create_population( string representation, int size ){
+
+	PopulationPtr pop = PopulationPtr( new Population( size ) );
+	const int max_cuts = min( 50, PROBLEM->ndata() - 1 );
+
+	for( int s = 0; s < size; s++ ){
+
+		SolutionPtr sol;
+
+		if( representation == "locus" ){
+
+			sol = SolutionPtr( new SolutionLocus( false ) );
+			for( int i = 0; i < PROBLEM->ndata(); i++ ) (*sol)[ i ] = PROBLEM->mst_edge( i );
+
+		}else if( representation == "short" ){
+
+			sol = SolutionPtr( new SolutionShort( false ) );
+			for( int i = 0; i < sol->encoding_length(); i++ ) (*sol)[ i ] = PROBLEM->mst_edge( PROBLEM->relevant_edge( i ) );
+
+		}else{
+
+			sol = SolutionPtr( new SolutionSplit( false ) );
+			for( int i = 0; i < sol->encoding_length(); i++ ) (*sol)[ i ] = 1;
+
+		}
+
+		for( int c = random_int( 1, max_cuts ); c > 0; c-- ){
+
+			int i = random_int( 0, sol->encoding_length() - 1 );
+
+			if( representation == "locus" ) (*sol)[ i ] = SolutionLocus::static_random_encoding( i, (*sol)[ i ] );
+			else if( representation == "short" ) (*sol)[ i ] = SolutionShort::static_random_encoding( i, (*sol)[ i ] );
+			else (*sol)[ i ] = 0;
+
+		}
+
+		pop->add( sol );
+
+	}
+
+	return pop;
+
+}
+////////////////////////////////////////////////////////////////////
+// Kernels on the current problem instance
+void Benchmark::run_kernels(){
+
+	const int n = PROBLEM->ndata();
+	ClusteringProblemPtr problem = PROBLEM;
+	volatile float sink = 0.0;
+
+	// ****************************
+	// Pre-computations
+	// ****************************
+
+	// Distance function: pseudo-random pairs of data elements
+	const int pairs = 1 << 16;
+	vector< int > first( pairs ), second( pairs );
+	for( int p = 0; p < pairs; p++ ){
+
+		first[ p ] = random_int( 0, n - 1 );
+		second[ p ] = random_int( 0, n - 1 );
+
+	}
+
+	measure( "euclidean_distance", [ & ]{
+
+		float sum = 0.0;
+		for( int p = 0; p < pairs; p++ ) sum += euclidean_distance( (*problem)[ first[ p ] ], (*problem)[ second[ p ] ], problem->mdim() );
+		sink = sum;
+
+	}, nullptr, pairs );
+
+	measure( "distance_matrix", [ & ]{ problem->compute_distance_matrix(); }, [ & ]{
+
+		deallocate_MatrixFloat( problem->_distance_matrix, n );
+
+	}, long( n ) * ( n - 1 ) / 2 );
+
+	measure( "knn", [ & ]{ problem->compute_nearest_neighbours(); }, [ & ]{
+
+		deallocate_MatrixInt( problem->_nearest_neighbours, n );
+		deallocate_MatrixInt( problem->_neighbour_rank, n );
+
+	}, n );
+
+	measure( "mst", [ & ]{ problem->compute_mst(); }, [ & ]{
+
+		deallocate_VectorInt( problem->_mst );
+		deallocate_VectorDouble( problem->_priority_edges );
+		deallocate_VectorInt( problem->_relevant_edges );
+		deallocate_VectorInt( problem->_fixed_edges );
+		delete[] problem->_is_fixed;
+		deallocate_VectorInt( problem->_relevant_index );
+
+	}, n );
+
+	// ****************************
+	// Evaluation
+	// ****************************
+
+	// Parent and offspring populations (2P solutions) of each representation
+	_cout = cout.rdbuf( nullptr );
+	problem->determine_relevant_edges();
+	const int size = 2 * _population_size;
+	PopulationPtr locus = create_population( "locus", size );
+	PopulationPtr reduced = create_population( "short", size );
+	PopulationPtr split = create_population( "split", size );
+	EvaluatorFullPtr evaluator_full = EvaluatorFullPtr( new EvaluatorFull() );
+	EvaluatorDeltaPtr evaluator_delta = EvaluatorDeltaPtr( new EvaluatorDelta() );
+	EvaluatorDeltaPtr evaluator_split = EvaluatorDeltaPtr( new EvaluatorDelta( true ) );
+	evaluator_full->evaluate( locus );
+	cout.rdbuf( _cout );
+	cout.clear();
+
+	measure( "evaluate_full", [ & ]{ evaluator_full->evaluate( locus ); }, nullptr, size );
+	measure( "evaluate_delta", [ & ]{ evaluator_delta->evaluate( reduced ); }, nullptr, size );
+	measure( "evaluate_delta_split", [ & ]{ evaluator_split->evaluate( split ); }, nullptr, size );
+
+	// ****************************
+	// Nondominated sorting, crowding distance
+	// ****************************
+
+	NondominatedSortingPtr nds = NondominatedSortingPtr( new NondominatedSorting( size ) );
+	nds->sort( locus );
+
+	measure( "nondominated_sorting", [ & ]{ nds->sort( locus ); }, nullptr, size );
+	measure( "crowding", [ & ]{ nds->crowding_distance_fronts( locus ); }, nullptr, size );
+
+	// ****************************
+	// Variation operators (P children per call, default probabilities)
+	// ****************************
+
+	SolutionPtr child1 = SolutionPtr( new SolutionLocus( false ) );
+	SolutionPtr child2 = SolutionPtr( new SolutionLocus( false ) );
+
+	measure( "crossover", [ & ]{
+
+		for( int i = 0; i < _population_size; i += 2 ) BinaryOperator::uniform_crossover( (*locus)[ i ], (*locus)[ i + 1 ], child1, child2, 1.0 );
+
+	}, nullptr, _population_size );
+
+	measure( "mutation_locus", [ & ]{
+
+		for( int i = 0; i < _population_size; i++ ) UnaryOperator::neighbourhood_biased_mutation( (*locus)[ i ], 1.0 );
+
+	}, nullptr, _population_size );
+
+	measure( "mutation_short", [ & ]{
+
+		for( int i = 0; i < _population_size; i++ ) UnaryOperator::neighbourhood_biased_mutation_short( (*reduced)[ i ], 1.0 );
+
+	}, nullptr, _population_size );
+
+	measure( "mutation_split", [ & ]{
+
+		for( int i = 0; i < _population_size; i++ ) UnaryOperator::neighbourhood_biased_mutation_split( (*split)[ i ], 1.0 );
+
+	}, nullptr, _population_size );
+
+	// Free memory
+	delete child1;
+	delete child2;
+	delete nds;
+	delete evaluator_full;
+	delete evaluator_delta;
+	delete evaluator_split;
+	delete locus;
+	delete reduced;
+	delete split;
+
+}
+////////////////////////////////////////////////////////////////////
+// Complete runs of the algorithm: initialisation and _generations generations (no output files)
+void Benchmark::run_end_to_end(){
+
+	const string representations[] = { "locus", "short", "split" };
+
+	for( const string & representation : representations ){
+
+		measure( "end_to_end_" + representation, [ & ]{
+
+			input_parameters.push_back( { "--representation", representation } );
+			TOTAL_INITIAL_SOLUTIONS = -1;
+			mock_Kmax = -1;
+
+			AlgorithmPtr algorithm = AlgorithmPtr( Nsga2::create() );
+			algorithm->run();
+			delete algorithm;
+
+			input_parameters.pop_back();
+
+		}, nullptr, _population_size * _generations );
+
+	}
+
+}
+////////////////////////////////////////////////////////////////////
+// Displays usage of the benchmark driver
+void show_bench_usage( string program_name ){
+
+	std::cout
+		<< "\n****************************************"
+		<< "****************************************\n"
+		<< "Delta-MOCK benchmarks\n\n"
+		<< "Usage:\n" << program_name << " [OPTION VALUE]...\n\n"
+		<< "      --file            Data set (repeatable; default: data sets of --suite)\n\n"
+		<< "      --suite           Data sets: { small, standard (default), large (UKC,"
+		<< " several GB of memory) }\n\n"
+		<< "      --kernels         Comma-separated list of kernels (default: all): euclidean_distance,"
+		<< " distance_matrix, knn, mst, evaluate_full, evaluate_delta, evaluate_delta_split,"
+		<< " nondominated_sorting, crowding, crossover, mutation_locus, mutation_short,"
+		<< " mutation_split, end_to_end_locus, end_to_end_short, end_to_end_split\n\n"
+		<< "      --repetitions     Measurements per kernel (default: 10)\n\n"
+		<< "      --warmup          Unmeasured calls before measuring (default: 2)\n\n"
+		<< "      --mintime         Minimum duration of a measurement, in seconds (default: 0.05)\n\n"
+		<< "      --population      Population size (default: 100)\n\n"
+		<< "      --generations     Generations of the end-to-end runs (default: 20)\n\n"
+		<< "      --delta           Delta parameter (default: 80)\n\n"
+		<< "      --normalise       Data normalisation: { true (default), false }\n\n"
+		<< "      --threads         Threads of the end-to-end runs (default: 1)\n\n"
+		<< "      --lparameter      Number of nearest neighbours (default: 10)\n\n"
+		<< "      --seed            Seed for the random numbers generator (default: 1)\n\n"
+		<< "      --output          Results file, one JSON object per kernel (default: bench_results.jsonl)\n\n"
+		<< "\n****************************************"
+		<< "****************************************\n"
+		<< std::endl;
+
+}
+////////////////////////////////////////////////////////////////////
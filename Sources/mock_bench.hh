@@ -0,0 +1,103 @@
+/*******************************************************************************
+Copyright (C) 2017 Mario Garza-Fabre, Julia Handl, Joshua Knowles
+
+This file is part of Delta-MOCK.
+
+Delta-MOCK is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Delta-MOCK is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Delta-MOCK. If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------
+
+Author: Mario Garza-Fabre (garzafabre@gmail.com)
+Last updated: 10 July 2017
+
+*******************************************************************************/
+
+#ifndef __MOCK_BENCH_HH__
+#define __MOCK_BENCH_HH__
+
+/******************
+Dependencies
+******************/
+#include "mock.hh"
+#include <functional>
+
+/******************
+Class definition
+******************/
+
+// Kernel and end-to-end benchmarks on one data set (make bench; ./delta_mock_bench --help)
+// Each kernel is warmed up, calibrated so that a measurement lasts at least --mintime seconds
+// (the kernel is then called 'inner' times per measurement), and measured --repetitions times.
+// One JSON object per line and kernel is written to the output file, with the time per kernel
+// call in seconds: min, median, mean, standard deviation, 95% confidence interval of the mean
+// (Student's t), and median absolute deviation. 'items' is the amount of work of a call 
+// (distances, solutions...), so that rates can be derived
+class Benchmark{
+
+	/******************
+	Attributes
+	******************/
+
+	private:
+
+		string _dataset;				// Data set file
+
+		vector< string > _kernels;		// Kernels to run (empty: all)
+
+		int _repetitions;				// Number of measurements per kernel
+
+		int _warmup;					// Number of unmeasured calls before calibration
+
+		double _min_time;				// Minimum duration of a measurement (seconds)
+
+		int _population_size;			// Number of parents (population kernels and end-to-end runs)
+
+		int _generations;				// Number of generations of the end-to-end runs
+
+		ofstream & _out;				// Results (JSON lines)
+
+		std::streambuf * _cout;			// Standard output (silenced while kernels run)
+
+	/******************
+	Methods
+	******************/
+
+	private:
+
+		bool selected( string kernel );
+		void measure( string kernel, std::function< void() > body, std::function< void() > setup = nullptr, long items = 1 );
+		void report( string kernel, vector< double > & times, long inner, long items );
+		PopulationPtr create_population( string representation, int size );
+
+	public:
+
+		// Constructor
+		Benchmark( string dataset, vector< string > kernels, int repetitions, int warmup, double min_time, 
+				   int population_size, int generations, ofstream & out );
+
+		// Kernels on the data set of PROBLEM (pre-computations, evaluation, sorting, variation)
+		void run_kernels();
+
+		// Complete runs of the algorithm (each representation)
+		void run_end_to_end();
+
+};
+
+/******************
+Prototypes
+******************/
+
+void show_bench_usage( string program_name );
+
+#endif